@@ -33,7 +33,9 @@ public:
 	~AAttachmentPoint();
 	
 	void delete_buffer_vector();
-	void new_buffer_vector(int total, int size);
+	void new_buffer_vector(int total, int size, int format);
+	void delete_convert_vector();
+	void new_convert_vector(int total, int size);
 	void render(Samples *output, 
 		int buffer_number,
 		int64_t start_position, 
@@ -48,6 +50,11 @@ public:
 // Buffers for multichannel plugins
 	Samples **buffer_vector;
 	int buffer_allocation;
+	int buffer_format;
+// Double buffers for plugins which don't process the format of the graph
+	Samples **convert_vector;
+	int convert_total;
+	int convert_allocation;
 };
 
 #endif
@@ -98,6 +98,7 @@ private:
 	ALSADevice *alsa_device;
 	BitsPopup *alsa_bits;
 	BC_CheckBox *alsa_workaround;
+	BC_CheckBox *alsa_low_latency;
 	ArrayList<BC_ListBoxItem*> *alsa_drivers;
 
 
@@ -112,6 +112,8 @@ public:
 	Samples *transition_temp;
 // Temporary buffer for rendering speed curve
 	Samples *speed_temp;
+// Temporary buffer for rendering to a format other than SAMPLES_DOUBLE
+	Samples *format_temp;
 // Previous buffers for rendering speed curve
 #define SPEED_OVERLAP 4
 	double prev_head[SPEED_OVERLAP];
@@ -303,6 +303,9 @@ public:
 	int ac3_bitrate;
 // Insert tag for spherical playback into quicktime
 	int mov_sphere;
+// Write a fragmented MP4 with a fragment every mov_fragment_seconds
+	int mov_fragment;
+	int mov_fragment_seconds;
 // Insert tag for spherical playback into JPEG
 	int jpeg_sphere;
 
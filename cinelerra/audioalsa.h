@@ -44,6 +44,7 @@ public:
 	int close_all();
 	int close_input();
 	int64_t device_position();
+	int64_t device_latency();
 	int flush_device();
 	int interrupt_playback();
 
@@ -51,7 +52,8 @@ private:
 	int close_output();
 	void translate_name(char *output, char *input);
 	snd_pcm_format_t translate_format(int format);
-	void set_params(snd_pcm_t *dsp, 
+// Returns 1 if the mmap access mode was configured
+	int set_params(snd_pcm_t *dsp, 
 		int channels, 
 		int bits,
 		int samplerate,
@@ -63,7 +65,11 @@ private:
 	int64_t samples_written;
 	Timer *timer;
 	int delay;
+// Frames between the hardware & the last transfer
+	int64_t latency;
 	Mutex *timer_lock;
+// Transfer with snd_pcm_mmap_* in low latency mode
+	int mmap_in, mmap_out;
 	int interrupted;
 };
 
@@ -45,6 +45,7 @@
 #include "mwindow.inc"
 #include "preferences.inc"
 #include "recordgui.inc"
+#include "ringbuffer.inc"
 #include "samples.inc"
 #include "sema.inc"
 #include "thread.h"
@@ -63,6 +64,8 @@ public:
 	virtual int close_all() { return 1; };
 	virtual int interrupt_crash() { return 0; };
 	virtual int64_t device_position() { return -1; };
+// Frames queued in the hardware for the open direction
+	virtual int64_t device_latency() { return -1; };
 	virtual int write_buffer(char *buffer, int size) { return 1; };
 	virtual int read_buffer(char *buffer, int size) { return 1; };
 	virtual int flush_device() { return 1; };
@@ -162,12 +165,27 @@ public:
 // Used by video devices to share audio devices
 	AudioLowLevel* get_lowlevel_out();
 	AudioLowLevel* get_lowlevel_in();
+// Samples between the hardware & the client for the open direction.
+// -1 if the driver doesn't know.
+	int64_t get_latency();
+	int get_low_latency();
 
 private:
 	int initialize();
 // Create a lowlevel driver out of the driver ID
 	int create_lowlevel(AudioLowLevel* &lowlevel, int driver);
 	int arm_buffer(int buffer, double **output, int samples);
+// Convert to the device format
+	void convert_output(char *buffer, double **output, int samples);
+// Low latency replacements for the buffer swapping
+	int write_ring(double **output, int samples);
+	void run_output_ring();
+	void run_input_ring();
+	void create_ring(RingBuffer* &ring, 
+		char* &period_buffer, 
+		int size, 
+		int frame);
+	void delete_rings();
 	int get_obits();
 	int get_ochannels();
 	int get_ibits();
@@ -219,6 +237,31 @@ private:
 	Condition *polling_lock;
 	int arm_buffer_num;
 
+// Low latency mode replaces the buffers with a ring for each direction
+// which the device thread transfers 1 period at a time.  The rings aren't
+// locked.  The conditions wake the side waiting for data or room.
+	int in_low_latency;
+	int out_low_latency;
+	RingBuffer *in_ring;
+	RingBuffer *out_ring;
+// Client side conversion buffers
+	char *in_ring_buffer;
+	int in_ring_buffer_size;
+	char *out_ring_buffer;
+	int out_ring_buffer_size;
+// Device side period buffers
+	char *in_period_buffer;
+	char *out_period_buffer;
+// Data was put in a ring
+	Condition *in_ring_data;
+	Condition *out_ring_data;
+// Room was made in the output ring
+	Condition *out_ring_space;
+// Guards out_ring_done
+	Mutex *ring_lock;
+// Set after the last sample is written to the output ring
+	int out_ring_done;
+
 // for position information
 	int total_samples;
 // samples in buffer
@@ -28,6 +28,7 @@
 #include "auto.h"
 #include "edl.inc"
 #include "guicast.h"
+#include "listindex.h"
 #include "filexml.inc"
 #include "track.inc"
 
@@ -87,6 +88,8 @@ public:
 
 	EDL *edl;
 	Track *track;
+// Autos by position
+	ListIndex<Auto, int64_t> index;
 // Default settings if no autos.
 // Having a persistent keyframe created problems when files were loaded and
 // we wanted to keep only 1 auto.
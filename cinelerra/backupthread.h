@@ -0,0 +1,60 @@
+/*
+ * CINELERRA
+ * Copyright (C) 2025 Adam Williams <broadcast at earthling dot net>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ */
+
+#ifndef BACKUPTHREAD_H
+#define BACKUPTHREAD_H
+
+#include "condition.inc"
+#include "mutex.inc"
+#include "mwindow.inc"
+#include "thread.h"
+
+#include <string>
+
+// Writes the backup file in the background.
+// The EDL is serialized in the GUI thread & only the newest copy waiting
+// to be written is kept, so a burst of edits writes the file once.
+
+class BackupThread : public Thread
+{
+public:
+	BackupThread(MWindow *mwindow);
+	~BackupThread();
+
+// Take the contents of data & schedule it for writing.
+	void write_backup(std::string *data);
+// Block until the last scheduled backup is on disk.
+	void flush();
+	void run();
+
+	MWindow *mwindow;
+	Condition *input_lock;
+	Condition *output_lock;
+	Mutex *data_lock;
+// newest backup not written yet
+	std::string data;
+	int have_data;
+// a backup is being written
+	int writing;
+	int done;
+};
+
+
+#endif
@@ -22,6 +22,7 @@
 #ifndef COMMONRENDER_H
 #define COMMONRENDER_H
 
+#include "arraylist.h"
 #include "cache.inc"
 #include "condition.inc"
 #include "virtualconsole.inc"
@@ -33,6 +34,10 @@
 
 #include <stdint.h>
 
+// Maximum virtual consoles cached for previous configurations before the
+// least recently used is deleted.  Each one holds its plugins open.
+#define VCONSOLE_CACHE_SIZE 8
+
 class CommonRender : public Thread
 {
 public:
@@ -43,6 +48,17 @@ public:
 	virtual int get_total_tracks() { return 0; };
 	virtual Module* new_module(Track *track) { return 0; };
 	void delete_vconsole();
+// Move the virtual console to the cache when reconfiguring
+	void cache_vconsole();
+// Take a cached virtual console built for the configuration at the
+// current position
+	VirtualConsole* get_cached_vconsole();
+// Delete the least recently used cached console & the retired attachments
+// only it used
+	void evict_vconsole();
+	void flush_vconsole_cache();
+// Identify the configuration of tracks & plugins at the current position
+	void get_signature(ArrayList<int> *signature);
 	void create_modules();
 	void reset_parameters();
 // Build the virtual console at the current position
@@ -69,6 +85,9 @@ public:
 	RenderEngine *renderengine;
 // Virtual console
 	VirtualConsole *vconsole;
+// Virtual consoles built for previous configurations during playback.
+// Crossing back into one of them costs a lookup instead of a rebuild.
+	ArrayList<VirtualConsole*> vconsole_cache;
 // Native units position in project used for all functions
 	int64_t current_position;       
 	Condition *start_lock;
@@ -30,6 +30,7 @@
 #include "edit.h"
 #include "filexml.inc"
 #include "linklist.h"
+#include "listindex.h"
 #include "track.inc"
 #include "transition.inc"
 
@@ -90,6 +91,8 @@ public:
 
 	EDL *edl;
 	Track *track;
+// Edits by startproject
+	ListIndex<Edit, int64_t> index;
 
 
 
@@ -101,7 +104,7 @@ public:
 
 
 // ============================= initialization commands ====================
-	Edits() { printf("default edits constructor called\n"); };
+	Edits() : index(this, &Edit::startproject) { printf("default edits constructor called\n"); };
 
 // ================================== file operations
 
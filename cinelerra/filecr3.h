@@ -28,6 +28,13 @@
 
 #include "filelist.h"
 
+#define RAW_CACHE_DIR "rawcache"
+#define RAW_CACHE_MAGIC "CINRAW02"
+// Change when the decoding changes to orphan the old frames
+#define RAW_CACHE_VERSION 1
+// The cache is trimmed after this fraction of its limit is written
+#define RAW_CACHE_TRIM 8
+
 class FileCR3 : public FileList
 {
 public:
@@ -50,12 +57,37 @@ public:
 //	int close_file();
 // Open file and decode.
 	int read_frame(VFrame *frame, char *path);
+	int read_frame(VFrame *frame, char *path, FrameReaderUnit *unit);
+	FrameReaderUnit* new_reader_unit(FrameReader *reader);
 // Get best colormodel for decoding.
 //	int colormodel_supported(int colormodel);
 //	int64_t get_memory_usage();
 	int read_frame_header(char *path);
 
 private:
+// Demosaiced frames are cached in BCASTDIR/RAW_CACHE_DIR as 16 bit RGB.
+// The key is the file & the develop settings.  The size & modification
+// time of the file are stored in the frame too, in case the key collides.
+// Return 1 if the cache is disabled.
+	int get_cache_path(char *output, 
+		char *path, 
+		int64_t *source_size, 
+		int64_t *source_time);
+	void get_cache_dir(char *output);
+	uint16_t* read_cache(char *cache_path, 
+		int64_t source_size, 
+		int64_t source_time, 
+		int &width, 
+		int &height);
+// image is 16 bit RGBA from libraw
+	void write_cache(char *cache_path, 
+		int64_t source_size, 
+		int64_t source_time, 
+		uint16_t *image, 
+		int width, 
+		int height);
+// Delete the least recently used frames until the cache fits in limit
+	void trim_cache(char *dir, int64_t limit);
 };
 
 
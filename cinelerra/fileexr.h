@@ -50,9 +50,11 @@ public:
 //	int colormodel_supported(int colormodel);
 	int read_frame_header(char *path);
 	int read_frame(VFrame *frame, VFrame *data);
+	int read_frame(VFrame *frame, VFrame *data, FrameReaderUnit *unit);
 	int64_t get_memory_usage();
 	int write_frame(VFrame *frame, VFrame *data, FrameWriterUnit *unit);
 	FrameWriterUnit* new_writer_unit(FrameWriter *writer);
+	FrameReaderUnit* new_reader_unit(FrameReader *reader);
 
 // exr_compression values
 	enum
@@ -49,10 +49,12 @@ public:
 
 //	int colormodel_supported(int colormodel);
 	int read_frame(VFrame *frame, VFrame *data);
+	int read_frame(VFrame *frame, VFrame *data, FrameReaderUnit *unit);
 	int write_frame(VFrame *frame, VFrame *data, FrameWriterUnit *unit);
 	int can_copy_from(Asset *asset, int64_t position);
 	int read_frame_header(char *path);
 	FrameWriterUnit* new_writer_unit(FrameWriter *writer);
+	FrameReaderUnit* new_reader_unit(FrameReader *reader);
 
 	void *decompressor;
 };
@@ -68,6 +70,15 @@ public:
 	void *compressor;
 };
 
+class JPEGReadUnit : public FrameReaderUnit
+{
+public:
+	JPEGReadUnit(FrameReader *reader);
+	~JPEGReadUnit();
+
+	void *decompressor;
+};
+
 class JPEGConfigVideo : public BC_Window
 {
 public:
@@ -24,9 +24,12 @@
 
 #include "file.inc"
 #include "filebase.h"
+#include "bctimer.inc"
+#include "condition.inc"
 #include "filelist.inc"
 #include "loadbalance.h"
 #include "mutex.inc"
+#include "thread.h"
 #include "vframe.inc"
 
 // Any file which is a list of frames.
@@ -61,10 +64,18 @@ public:
 	int read_list_header();
 	virtual int read_frame_header(char *path) { return 1; };
 	int read_frame(VFrame *frame);
+// Read & decode 1 frame of a list on the caller's thread or a reader unit
+	int read_list_frame(VFrame *frame, 
+		int64_t number, 
+		VFrame *data, 
+		FrameReaderUnit *unit);
 
 // subclass returns whether the asset format is a list or single file
 	virtual int read_frame(VFrame *frame, VFrame *data) { return 0; };
 	virtual int read_frame(VFrame *frame, char *path) { return 0; };
+// Decode on a FrameReader thread.  Per thread state must come from the unit.
+	virtual int read_frame(VFrame *frame, VFrame *data, FrameReaderUnit *unit) { return 0; };
+	virtual int read_frame(VFrame *frame, char *path, FrameReaderUnit *unit) { return 0; };
 	virtual int write_frame(VFrame *frame, VFrame *data, FrameWriterUnit *unit) { return 0; };
 // Return 1 if read frame should use the path instead of the compressed data
 	virtual int use_path();
@@ -73,12 +84,15 @@ public:
 	int write_frames(VFrame ***frames, int len);
 	VFrame* read_frame(int use_alpha, int use_float);
 	virtual int64_t get_memory_usage();
+	int64_t purge_cache();
 // Get the total writer units for calculating memory usage
 	int get_units();
 // Get a writer unit for retrieving temporary usage.
 	FrameWriterUnit* get_unit(int number);
 
 	virtual FrameWriterUnit* new_writer_unit(FrameWriter *writer);
+// Return 0 if the subclass can't decode on several threads.
+	virtual FrameReaderUnit* new_reader_unit(FrameReader *reader);
 
 // Temp storage for compressed data
 	VFrame *data;
@@ -103,6 +117,9 @@ private:
 	int list_type;
 	Mutex *table_lock;
 	FrameWriter *writer;
+	FrameReader *reader;
+// the subclass can't read ahead
+	int no_reader;
 	int return_value;
 	int first_number;
 	int number_start;
@@ -143,6 +160,92 @@ public:
 
 
 
+// Upcoming frames of a list are decoded in parallel, 1 frame per thread,
+// in the direction of playback.  The frames are bounded by the read ahead
+// memory in Preferences.
+
+class FrameReaderPackage
+{
+public:
+	FrameReaderPackage();
+	~FrameReaderPackage();
+
+	VFrame *frame;
+	int64_t number;
+	int state;
+	int result;
+};
+
+
+
+
+class FrameReaderUnit : public Thread
+{
+public:
+	FrameReaderUnit(FrameReader *server);
+	virtual ~FrameReaderUnit();
+
+	void run();
+// Get a temporary for decoding in a different colormodel than the output
+	VFrame* get_temp(int color_model, int w, int h);
+
+	FrameReader *server;
+// compressed data
+	VFrame *data;
+	VFrame *temp;
+};
+
+
+
+
+
+class FrameReader
+{
+public:
+	FrameReader(FileList *file, int cpus, int64_t memory_limit);
+	~FrameReader();
+
+// Copy 1 frame to the output & schedule the frames after it.
+	int read_frame(VFrame *frame, int64_t number);
+	int64_t get_memory_usage();
+// Delete frames not being decoded if the reader is idle.
+// Return the bytes freed.
+	int64_t purge();
+
+// Called by the units
+	FrameReaderPackage* get_package();
+	void package_done(FrameReaderPackage *package);
+
+	enum
+	{
+		PACKAGE_IDLE,
+		PACKAGE_QUEUED,
+		PACKAGE_READING,
+		PACKAGE_DONE
+	};
+
+	FileList *file;
+	ArrayList<FrameReaderUnit*> units;
+	ArrayList<FrameReaderPackage*> packages;
+	Mutex *lock;
+// a package was queued
+	Condition *input_lock;
+// a package was decoded
+	Condition *output_lock;
+	int64_t memory_limit;
+// time since the last read_frame
+	Timer *timer;
+// last frame read & the direction it moved in
+	int64_t position;
+	int direction;
+	int done;
+};
+
+
+
+
+
+
 class FrameWriter : public LoadServer
 {
 public:
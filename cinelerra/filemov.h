@@ -35,31 +35,12 @@
 #include "quicktime.h"
 #include "thread.h"
 
-class FileMOVThread;
-
-class ThreadStruct
-{
-public:
-	ThreadStruct();
-	~ThreadStruct();
-
-	void load_output(mjpeg_t *mjpeg);
-
-	VFrame *input;
-	unsigned char *output;  // Output buffer
-	int64_t output_size;        // Size of output buffer
-	int64_t output_allocated;  // Allocation of output buffer
-	Condition *completion_lock;
-};
-
 class FileMOV : public FileBase
 {
 public:
 	FileMOV(Asset *asset, File *file);
 	~FileMOV();
 
-	friend class FileMOVThread;
-
 
 // table functions
     FileMOV();
@@ -119,14 +100,6 @@ private:
 	int64_t frames_correction;  // Correction after 32bit overflow
 	int64_t samples_correction;  // Correction after 32bit overflow
 
-// An array of frames for threads to look up and compress on their own.
-	ArrayList<ThreadStruct*> threadframes;
-
-	int total_threadframes;     // Number of thread frames in this buffer
-	int current_threadframe;    // Next threadframe to compress
-	Mutex *threadframe_lock;     // Lock threadframe array.
-
-	FileMOVThread **threads;   // One thread for every CPU
 	char prefix_path[1024];    // Prefix for new file when 2G limit is exceeded
 	int suffix_number;         // Number for new file
 
@@ -136,29 +109,6 @@ private:
 };
 
 
-// Encoder thread to parallelize certain compression formats, mainly JPEG.
-// Only works when no alpha.
-
-class FileMOVThread : public Thread
-{
-public:
-	FileMOVThread(FileMOV *filemov, int fields);
-	~FileMOVThread();
-
-	int start_encoding();
-	int stop_encoding();
-	int encode_buffer();
-	void run();
-
-	ThreadStruct *threadframe;    // The frame currently being processed.
-	int done;
-	FileMOV *filemov;
-	Condition *input_lock;     // Wait for new array of threads or completion.
-	mjpeg_t *mjpeg;
-	int fields;
-};
-
-
 class MOVConfigAudioNum;
 class MOVConfigAudioPopup;
 class MOVConfigAudioToggle;
@@ -256,6 +206,8 @@ public:
 	void reset();
 
 	void update_parameters();
+// Options for fragmented MP4 below the codec parameters
+	void create_fragment_objects(int x, int y);
 
 	ArrayList<BC_ListBoxItem*> compression_items;
 	MOVConfigVideoPopup *compression_popup;
@@ -294,6 +246,8 @@ public:
 
 
 	MOVConfigVideoCheckBox *mov_sphere;
+	MOVConfigVideoCheckBox *mov_fragment;
+	MOVConfigVideoNum *mov_fragment_seconds;
 };
 
 class MOVConfigVideoPopup : public BC_PopupTextBox
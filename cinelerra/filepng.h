@@ -50,9 +50,11 @@ public:
 
 //	int colormodel_supported(int colormodel);
 	int read_frame(VFrame *frame, VFrame *data);
+	int read_frame(VFrame *frame, VFrame *data, FrameReaderUnit *unit);
 	int write_frame(VFrame *frame, VFrame *data, FrameWriterUnit *unit);
 	int can_copy_from(Asset *asset, int64_t position);
 	FrameWriterUnit* new_writer_unit(FrameWriter *writer);
+	FrameReaderUnit* new_reader_unit(FrameReader *reader);
 
 	int read_frame_header(char *path);
 
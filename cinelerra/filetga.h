@@ -59,8 +59,10 @@ public:
 	int can_copy_from(Asset *asset, int64_t position);
 //	int colormodel_supported(int colormodel);
 	int read_frame(VFrame *frame, VFrame *data);
+	int read_frame(VFrame *frame, VFrame *data, FrameReaderUnit *unit);
 	int write_frame(VFrame *frame, VFrame *data, FrameWriterUnit *unit);
 	FrameWriterUnit* new_writer_unit(FrameWriter *writer);
+	FrameReaderUnit* new_reader_unit(FrameReader *reader);
 
 // For decoding only
 	VFrame *temp;
@@ -60,8 +60,10 @@ public:
 //	int colormodel_supported(int colormodel);
 	int read_frame_header(char *path);
 	int read_frame(VFrame *output, VFrame *input);
+	int read_frame(VFrame *output, VFrame *input, FrameReaderUnit *unit);
 	int write_frame(VFrame *frame, VFrame *data, FrameWriterUnit *unit);
 	FrameWriterUnit* new_writer_unit(FrameWriter *writer);
+	FrameReaderUnit* new_reader_unit(FrameReader *reader);
 
 	enum
 	{
@@ -21,17 +21,28 @@
 #ifndef FILEXML_H
 #define FILEXML_H
 
+#include "arraylist.h"
 #include "bcwindowbase.inc"
 #include "sizes.h"
 #include <stdio.h>
 #include <string>
-#include <map>
 
 //#define MAX_TITLE 1024
 //#define MAX_PROPERTIES 1024
 //#define MAX_LENGTH 4096
 using std::string;
-using std::multimap;
+
+
+// A key, value pair in a tag.
+// The key is interned by XMLTag::intern so keys are compared by pointer.
+// The value keeps its allocation when the tag is reset so reading
+// thousands of tags doesn't allocate.
+class XMLProperty
+{
+public:
+	const char *key;
+	std::string value;
+};
 
 
 class XMLTag
@@ -75,25 +86,53 @@ public:
 	void set_property(const char *text, float value);
 	void set_property(const char *text, double value);
     int has_property(const char *text);
+// append the tag to output
+	void write_tag(std::string *output);
 	int write_tag();
 
 // encode the special character at the head of the string
 // TODO: move to FileXML
  	static const char* encode_char(char *temp_string, char c);
+// append text to output with the special characters encoded
+	static void encode_text(std::string *output, const char *text, int len);
 
 // convert all the encodings to special characters
     void decode_text(char *text);
 
-	std::string tag_title;       // title of this tag
+// Return the shared copy of a tag title or property key or 0 if the table is full.
+// Names are never freed, so the pointers can be compared instead of the text.
+	static const char* intern(const char *text, int len);
+// Return the shared copy if it exists or 0 if the name was never interned.
+	static const char* find_name(const char *text);
 
+// Number parsing & formatting without the C library.
+// Results are identical to atoi, atof & the %d, %lld printf formats.
+	static int64_t parse_int(const char *text);
+	static double parse_float(const char *text);
+	static int format_int(char *output, int64_t value);
 
-// key, value list of properties for this tag
-    multimap<string, string> properties;
+	const char *tag_title;       // title of this tag
+
+
+// key, value list of properties for this tag sorted by key.
+// Only the first total entries are used.  The rest are kept for reuse.
+	ArrayList<XMLProperty*> properties;
+	int total;
 
     std::string text;
 	char temp1[BCTEXTLEN];
-	char temp2[BCTEXTLEN];
 	char left_delimiter, right_delimiter;
+
+private:
+	const char* lookup(const char *key);
+	void set_property(const char *key, const char *value, int len);
+	XMLProperty* new_property(const char *key);
+	XMLProperty* find_property(const char *key);
+// Return the shared copy of a name or a copy owned by this tag.
+	const char* get_name(const char *text, int len);
+
+// Names which didn't fit in the intern table.  Freed when the tag is reset.
+	ArrayList<char*> names;
 };
 
 
@@ -28,22 +28,55 @@
 #include <stdint.h>
 
 
+// Precomputed bit reversal & twiddle factors for 1 transform size.
+// Shared by all the FFT objects in the process.
+class FFTPlan
+{
+public:
+	FFTPlan(unsigned int bits);
+	~FFTPlan();
+
+	unsigned int samples;
+	unsigned int bits;
+// bit reversed index of each sample
+	unsigned int *reverse;
+// Twiddle factors of every butterfly stage.  The stage with half size m
+// uses entries m to 2m - 1.  Smaller transforms use the same entries.
+	double *cos_table;
+	double *sin_table;
+	float *cos_tablef;
+	float *sin_tablef;
+};
+
 class FFT
 {
 public:
 	FFT();
 	~FFT();
 
+// If imag_in is 0, the input is treated as real & transformed with a
+// half size complex FFT.  The output is still the full symmetric spectrum.
 	int do_fft(unsigned int samples,  // must be a power of 2
     	int inverse,         // 0 = forward FFT, 1 = inverse
     	double *real_in,     // array of input's real samples
     	double *imag_in,     // array of input's imag samples
     	double *real_out,    // array of output's reals
     	double *imag_out);   // array of output's imaginaries
+// single precision version
+	int do_fft(unsigned int samples,
+    	int inverse,
+    	float *real_in,
+    	float *imag_in,
+    	float *real_out,
+    	float *imag_out);
 	int symmetry(int size, double *freq_real, double *freq_imag);
 	unsigned int samples_to_bits(unsigned int samples);
 	unsigned int reverse_bits(unsigned int index, unsigned int bits);
 	virtual int update_progress(int current_position);
+
+// Get the cached plan for a transform size of 1 << bits.
+// Creates it on the 1st call.
+	static FFTPlan* get_plan(unsigned int bits);
 };
 
 class CrossfadeFFT : public FFT
@@ -27,6 +27,7 @@
 #include "guicast.h"
 #include "filexml.inc"
 #include "labels.inc"
+#include "listindex.h"
 #include "mwindow.inc"
 #include "recordlabel.inc"
 #include "stringfile.inc"
@@ -91,10 +92,14 @@ public:
 	Label* next_label(double position);
 
 	Label* label_of(double position); // first label on or after position
+// Label equivalent to position or 0
+	Label* label_at(double position);
 	MWindow *mwindow;
 	TimeBar *timebar;
 	EDL *edl;
 	char *xml_tag;
+// Labels by position
+	ListIndex<Label, double> index;
 };
 
 #endif
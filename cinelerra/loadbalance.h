@@ -65,6 +65,8 @@ public:
 
 	int done;
 	int package_number;
+// NUMA node the thread is pinned to or -1
+	int node;
 	Condition *input_lock;
 	Condition *completion_lock;
 	LoadServer *server;
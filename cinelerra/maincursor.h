@@ -38,12 +38,13 @@ public:
 	int repeat_event(int64_t duration);
 	void draw(int flash);
 	void hide(int do_plugintoggles = 1);
-	void flash();
+	void flash(int flush = 1);
 	void activate();
 	void deactivate();
 	void show(int do_plugintoggles = 1);
 	void restore(int do_plugintoggles);
-	void update();
+// Only flashes the old & new cursor
+	void update(int do_plugintoggles = 1, int flush = 1);
 	void focus_in_event();
 	void focus_out_event();
 
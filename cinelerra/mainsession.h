@@ -204,6 +204,11 @@ public:
 
 
 	double actual_frame_rate;
+// Presentation statistics of the current playback session
+	int64_t late_frames;
+	int64_t dropped_frames;
+// Standard deviation of the presentation time from the audio clock in seconds
+	double frame_jitter;
 
 // Tip of the day
 	int current_tip;
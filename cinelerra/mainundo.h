@@ -50,6 +50,9 @@ public:
 		uint32_t load_flags,
 		int changes_made = 1);
 
+// Apply the undo limits in the preferences
+	void update_limits();
+
 // Used in undo and redo to reset the creators in all the records.
 	void reset_creators();
 // called by save routines to make the current entry the only unmodified one
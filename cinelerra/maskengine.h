@@ -30,6 +30,8 @@
 #include "mutex.inc"
 #include "vframe.inc"
 
+#include <stdint.h>
+
 
 class MaskEngine;
 
@@ -42,6 +44,32 @@ enum
 	DO_APPLY
 };
 
+// Number of rasterized masks to keep
+#define MASK_CACHE_SIZE 4
+
+// Polygon edge flattened from the bezier curves, in mask pixels
+typedef struct
+{
+	float x1, y1, x2, y2;
+// point set the edge belongs to
+	int set;
+} mask_edge_t;
+
+// Rasterized mask & the parameters which made it
+class MaskCacheItem
+{
+public:
+	MaskCacheItem();
+	~MaskCacheItem();
+
+	VFrame *mask;
+	uint64_t hash;
+// Parameters & points compared when the hash matches
+	ArrayList<unsigned char> key;
+// Last time it was used
+	int64_t age;
+};
+
 class MaskPackage : public LoadPackage
 {
 public:
@@ -64,23 +92,17 @@ public:
 		int x2, 
 		int y2, 
 		unsigned char value);
-	void do_feather(VFrame *output,
+// Scanline fill the closed polygons into coverage
+	void fill_polygons(VFrame *output, int start_y, int end_y);
+// Convert coverage into mask values
+	void coverage_to_mask(VFrame *output, 
 		VFrame *input, 
-		double feather, 
 		int start_y, 
-		int end_y, 
-		int start_x, 
-		int end_x);
-	void blur_strip(double *val_p, 
-		double *val_m, 
-		double *dst, 
-		double *src, 
-		int size,
-		int max);
-
-    double n_p[5], n_m[5];
-    double d_p[5], d_m[5];
-    double bd_p[5], bd_m[5];
+		int end_y);
+// Distance transform in the columns & then the rows
+	void distance_columns(int start_x, int end_x);
+	void distance_rows(int start_y, int end_y);
+
 	MaskEngine *engine;
 // oversampled destination of mask
 	VFrame *temp;
@@ -101,9 +123,13 @@ public:
 		int64_t start_position_project,
 		MaskAutos *keyframe_set, 
 		MaskAuto *keyframe,
-		MaskAuto *default_auto);
-	int points_equivalent(ArrayList<MaskPoint*> *new_points, 
-		ArrayList<MaskPoint*> *points);
+		MaskAuto *default_auto,
+// 0 if the caller applies the mask itself
+		int apply = 1);
+// Store everything which goes into the rasterized mask in key & 
+// return its hash
+	uint64_t hash_mask(int w, int h, int color_model);
+	void flatten_polygons();
 
 	void delete_packages();
 	void init_packages();
@@ -111,11 +137,20 @@ public:
 	LoadPackage* new_package();
 
 	VFrame *output;
-// State of last mask
+// State of last mask.  Owned by the cache.
 	VFrame *mask;
-// Temporary for feather & outline
+// Coverage before feathering
 	VFrame *temp_mask;
+// Squared distance to the nearest pixel on the other side of the edge,
+// in the column.  For feathering.
+	float *distance;
+	int distance_allocated;
 	ArrayList<ArrayList<MaskPoint*>*> point_sets;
+	ArrayList<mask_edge_t> edges;
+	MaskCacheItem *cache[MASK_CACHE_SIZE];
+	int64_t cache_age;
+// Parameters of the current mask
+	ArrayList<unsigned char> key;
 	int mode;
 	int step;
 	double feather;
@@ -22,6 +22,7 @@
 #ifndef MODULE_H
 #define MODULE_H
 
+#include "arraylist.h"
 #include "attachmentpoint.inc"
 #include "cache.inc"
 #include "commonrender.inc"
@@ -64,6 +65,16 @@ public:
 	virtual AttachmentPoint* new_attachment(Plugin *plugin) { return 0; };
 	virtual int get_buffer_size() { return 0; };
 	int test_plugins();
+// Append the plugins which would be attached at the current position & 
+// their configurations
+	void get_signature(ArrayList<int> *signature, int playable);
+// Make the attachments of a cached virtual console current
+	void restore_attachments(AttachmentPoint **saved, int total);
+// Remove a retired attachment for the plugin from the retired list
+	AttachmentPoint* take_retired(Plugin *plugin);
+	void flush_retired();
+// Delete the attachment if it's retired
+	void delete_retired(AttachmentPoint *attachment);
 	AttachmentPoint* attachment_of(Plugin *plugin);
 	
 // Get attachment number or return 0 if out of range.
@@ -121,6 +132,9 @@ public:
 // from resetting
 	AttachmentPoint **new_attachments;
 	int new_total_attachments;
+// AttachmentPoints swapped out during playback which cached virtual consoles
+// still point to.  Deleted when the cache is flushed.
+	ArrayList<AttachmentPoint*> retired_attachments;
 };
 
 #endif
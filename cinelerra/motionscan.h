@@ -75,6 +75,9 @@ public:
 	void single_pixel(MotionScanPackage *pkg);
 
 	MotionScan *server;
+// least difference of the packages processed by this client in the current
+// pass.  Used to stop the difference of a package early.
+	int64_t best_difference;
 };
 
 class MotionScan : public LoadServer
@@ -120,13 +123,16 @@ public:
 		double rotation_center, // in deg
 		double rotation_range);
 
+// Sum of the squared differences.  Stops early once the sum exceeds 
+// threshold.  A threshold of -1 scans the entire block.
 	static int64_t abs_diff(unsigned char *prev_ptr,
 		unsigned char *current_ptr,
 		int prev_row_bytes,
 		int current_row_bytes,
 		int w,
 		int h,
-		int color_model);
+		int color_model,
+		int64_t threshold = -1);
 	static int64_t abs_diff_sub(unsigned char *prev_ptr,
 		unsigned char *current_ptr,
 		int prev_row_bytes,
@@ -135,7 +141,8 @@ public:
 		int h,
 		int color_model,
 		int sub_x,
-		int sub_y);
+		int sub_y,
+		int64_t threshold = -1);
 
 
 	static void clamp_scan(int w, 
@@ -31,6 +31,7 @@
 #include "autos.inc"
 #include "autoconf.inc"
 #include "awindow.inc"
+#include "backupthread.inc"
 #include "batchrender.inc"
 #include "bcprogressbox.inc"
 #include "bcwindowbase.inc"
@@ -551,6 +552,7 @@ public:
     static MWindow *instance;
 	static Playback3D *playback_3d;
 	RemoveThread *remove_thread;
+	BackupThread *backup_thread;
     AssetRemoveThread *asset_remove;
     TransitionDialogThread *attach_transition;
     EditKeyframeThread *edit_keyframe;
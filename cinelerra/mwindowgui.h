@@ -41,6 +41,7 @@
 #include "samplescroll.inc"
 #include "statusbar.inc"
 #include "timelinepane.inc"
+#include "track.inc"
 #include "trackcanvas.inc"
 #include "trackscroll.inc"
 #include "transitionpopup.inc"
@@ -85,6 +86,9 @@ public:
 		int clock,
 		int buttonbar);
 	void draw_overlays(int flash_it, int flush_it = 1);
+// Limit the next draw_overlays to the changed parts of the timeline
+	void damage_track(Track *track);
+	void damage_position(double position);
 	void draw_indexes(Indexable *indexable);
 //	void update_title(char *path);
 	void update_timebar(int flush_it);
@@ -102,7 +106,7 @@ public:
 	void draw_cursor(int do_plugintoggles);
 	void show_cursor(int do_plugintoggles /* = 1 */);
 	void hide_cursor(int do_plugintoggles /* = 1 */);
-	void update_cursor();
+	void update_cursor(int do_plugintoggles = 1, int flush = 1);
 	void set_playing_back(int value);
 	void set_editing_mode(int flush);
 	void set_meter_format(int mode, int min, int max);
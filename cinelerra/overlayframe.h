@@ -41,6 +41,25 @@ public:
   int type;
 };
 
+// Copy of an input row with the alpha scaled by a fade and a mask.
+// Lets the fade & mask be applied while the input is overlaid instead of
+// in separate passes over the input.  Only the columns in the span are
+// scaled and the last row is kept, so a row read again by consecutive
+// output rows is only scaled once.
+class OverlayAlphaRow {
+ public:
+  OverlayAlphaRow();
+  ~OverlayAlphaRow();
+// Set the input columns read by the package & drop the cached row
+  void set_span(int x1, int x2);
+  unsigned char* get_row(VFrame *input, VFrame *mask, float fade, int row);
+
+  unsigned char *data;
+  int allocated;
+  int row;
+  int x1, x2;
+};
+
 class DirectEngine;
 
 class DirectPackage : public LoadPackage{
@@ -72,6 +91,7 @@ class DirectUnit : public LoadClient{
   ~DirectUnit();
   void process_package(LoadPackage *package);
   DirectEngine *engine;
+  OverlayAlphaRow alpha_row;
 };
 
 class NNUnit : public LoadClient{
@@ -80,6 +100,7 @@ class NNUnit : public LoadClient{
   ~NNUnit();
   void process_package(LoadPackage *package);
   NNEngine *engine;
+  OverlayAlphaRow alpha_row;
 };
 
 class SampleUnit : public LoadClient{
@@ -88,6 +109,7 @@ class SampleUnit : public LoadClient{
   ~SampleUnit();
   void process_package(LoadPackage *package);
   SampleEngine *engine;
+  OverlayAlphaRow alpha_row;
 };
 
 class DirectEngine : public LoadServer{
@@ -109,6 +131,9 @@ class DirectEngine : public LoadServer{
   int out_y2;
   float alpha;
   int mode;
+// Scale the input alpha by these before blending
+  float fade;
+  VFrame *mask;
 };
 
 class NNEngine : public LoadServer{
@@ -134,9 +159,14 @@ class NNEngine : public LoadServer{
   float out_y2;
   float alpha;
   int mode;
+// Scale the input alpha by these before blending
+  float fade;
+  VFrame *mask;
 
   int *in_lookup_x;
   int *in_lookup_y;
+// Input columns read by the lookup
+  int in_col1, in_col2;
 };
 
 class SampleEngine : public LoadServer{
@@ -163,6 +193,9 @@ class SampleEngine : public LoadServer{
 
   float alpha;
   int mode;
+// Scale the input alpha by these before blending
+  float fade;
+  VFrame *mask;
 
   int *lookup_sx0;
   int *lookup_sx1;
@@ -188,7 +221,12 @@ class OverlayFrame{
               float out_y2,
               float alpha,
               int mode,
-              int interpolation_type);
+              int interpolation_type,
+// Multiply the input alpha by fade and mask like FadeEngine and
+// MaskEngine would, without modifying the input.
+// Only for color models with alpha.  The mask is the size of the input.
+              float fade = 1,
+              VFrame *mask = 0);
 
   DirectEngine *direct_engine;
   NNEngine *nn_engine;
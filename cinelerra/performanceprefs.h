@@ -142,6 +142,72 @@ public:
 	PreferencesWindow *pwindow;
 };
 
+class PrefsAudioFloat : public BC_CheckBox
+{
+public:
+	PrefsAudioFloat(PreferencesWindow *pwindow, int x, int y);
+	
+	int handle_event();
+	
+	PreferencesWindow *pwindow;
+};
+
+// Integer preference clamped to min, max
+class PrefsIntValue : public BC_TumbleTextBox
+{
+public:
+	PrefsIntValue(PerformancePrefs *subwindow, 
+		int x, 
+		int y, 
+		int *output, 
+		int min, 
+		int max);
+
+	int handle_event();
+
+	int *output;
+	int min;
+	int max;
+};
+
+class PrefsUndoJournal : public BC_CheckBox
+{
+public:
+	PrefsUndoJournal(PreferencesWindow *pwindow, int x, int y);
+	
+	int handle_event();
+	
+	PreferencesWindow *pwindow;
+};
+
+// Popup for 1 of the frame memory policies in bcnuma.h
+class PrefsVFramePolicy : public BC_PopupMenu
+{
+public:
+	PrefsVFramePolicy(int x, 
+		int y, 
+		int *output, 
+		const char **titles, 
+		int total);
+
+	void create_objects();
+	int handle_event();
+
+	int *output;
+	const char **titles;
+	int total;
+};
+
+class PrefsVFramePolicyItem : public BC_MenuItem
+{
+public:
+	PrefsVFramePolicyItem(PrefsVFramePolicy *popup, const char *text, int value);
+
+	int handle_event();
+	PrefsVFramePolicy *popup;
+	int value;
+};
+
 class PrefsGLRendering : public BC_CheckBox
 {
 public:
@@ -62,6 +62,8 @@ public:
 	char alsa_out_device[BCTEXTLEN];
 	int alsa_out_bits;
 	int interrupt_workaround;
+// Small mmap periods & a realtime device thread for monitoring
+	int alsa_low_latency;
 
 // Firewire options
 	int firewire_channel;
@@ -68,6 +68,9 @@ public:
 	int init_realtime_parameters();
 
 	int is_audio();
+// Mask of the sample formats process_buffer takes.  The server converts
+// buffers in other formats to SAMPLES_DOUBLE.
+	virtual int get_sample_formats();
 // These should return 1 if error or 0 if success.
 // Multichannel buffer process for backwards compatibility
 	virtual int process_realtime(int64_t size, 
@@ -198,6 +198,8 @@ public:
 		int64_t sample_rate,
 		int64_t total_len,
 		int direction);
+// Sample formats the audio client processes
+	int get_sample_formats();
 
 // Called by rendering client to cause the GUI to display something with the data.
 	void send_render_gui(void *data);
@@ -82,6 +82,8 @@ public:
 // Determined by /proc/cpuinfo and force_uniprocessor.
 // interactive forces it to ignore force_uniprocessor
 	int calculate_processors(int interactive = 0);
+// Copy the frame memory policies to BC_Resources
+	void apply_vframe_policy();
 
 // translate speed table to a command & value
     float get_playback_value(int index);
@@ -105,6 +107,22 @@ public:
 	double render_preroll;
 	int brender_preroll;
 	int force_uniprocessor;
+// Carry audio between tracks, plugins & the mixer in float instead of double
+	int audio_float;
+// Page size & NUMA placement of large frames.  Defined in bcnuma.h
+	int vframe_huge_pages;
+	int vframe_numa;
+// Undo operations to keep
+	int undo_levels;
+// Memory for undo in MB
+	int undo_memory;
+// Move undo beyond the memory limit to a journal in BCASTDIR
+// instead of deleting it
+	int undo_journal;
+// Memory for decoding image sequences ahead of playback in MB.  0 disables it.
+	int read_ahead;
+// Disk space for demosaiced camera raw frames in MB.  0 disables it.
+	int raw_cache;
 // The number of cpus to use when rendering.
 // Determined by /proc/cpuinfo and force_uniprocessor
 	int processors;
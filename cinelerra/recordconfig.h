@@ -53,6 +53,8 @@ public:
 	int esound_in_port;
 	char alsa_in_device[BCTEXTLEN];
 	int alsa_in_bits;
+// Small mmap periods & a realtime device thread for monitoring
+	int alsa_low_latency;
 	int in_samplerate;
 
 // This should come from EDLSession::recording_format
@@ -92,6 +92,9 @@ public:
 
 // Update preferences window
 	void update_framerate(float framerate);
+	void update_playback_stats(int64_t late_frames, 
+		int64_t dropped_frames, 
+		double frame_jitter);
 
 // Copy of command
 	TransportCommand *command;
@@ -25,8 +25,10 @@
 #ifndef RESAMPLE_H
 #define RESAMPLE_H
 
+// Phases in the filter bank
 #define BPC 160
-#define BLACKSIZE 25
+// History length.  Must be longer than the longest filter.
+#define BLACKSIZE 53
 
 #include "resample.inc"
 #include "samples.inc"
@@ -53,8 +55,17 @@ public:
 // If reverse, the end of the buffer.
 		int64_t out_position,
 		int direction);
+// Resample by an arbitrary ratio of input rate / output rate.
+// The ratio may change between calls without resetting the filter.
+	int resample(Samples *samples,
+		int64_t out_len,
+		double ratio,
+		int64_t out_position,
+		int direction);
 
 	int get_direction();
+// Select the filter length.  RESAMPLE_FAST, RESAMPLE_NORMAL, RESAMPLE_BEST
+	void set_quality(int quality);
 
 	static void reverse_buffer(double *buffer, int64_t len);
 
@@ -69,8 +80,9 @@ private:
 // Resamples input and dumps it to output_temp
 	void resample_chunk(Samples *input,
 		int64_t in_len,
-		int in_rate,
-		int out_rate);
+		double resample_ratio);
+// Recompute the filter bank if the cutoff or length changed
+	void init_filter(double fcn, int filter_l);
 	int read_chunk(Samples *input, 
 		int64_t len);
 
@@ -97,9 +109,15 @@ private:
 	int64_t input_size;
 	int64_t output_position;
 	int resample_init;
-// Last sample ratio configured to
-	double last_ratio;
-	double blackfilt[2 * BPC + 1][BLACKSIZE];
+	int quality;
+// Filter the bank was computed for
+	double last_fcn;
+	int last_filter_l;
+// Coefficients of each phase, padded to filter_stride with 0
+	double *blackfilt;
+	int filter_stride;
+// History followed by the start of the input chunk
+	double *start_buffer;
 };
 
 #endif
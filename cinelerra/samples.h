@@ -25,6 +25,8 @@
 
 // An object which contains samples
 
+#include "samples.inc"
+#include <stdint.h>
 
 
 class Samples
@@ -36,6 +38,8 @@ public:
 	Samples(int samples);
 // Allocate number of samples
 	Samples(int samples, int use_shm);
+// Allocate number of samples in a format other than SAMPLES_DOUBLE
+	Samples(int samples, int use_shm, int format);
 // Share memory with another buffer
 	Samples(Samples *src);
 	virtual ~Samples();
@@ -44,9 +48,17 @@ public:
 	void clear_objects();
     void clear();
 	void share(int shmid);
-	void allocate(int samples, int use_shm);
-// Get the buffer
+	void allocate(int samples, int use_shm, int format = SAMPLES_DOUBLE);
+// Get the buffer if the format is SAMPLES_DOUBLE
 	double* get_data();
+// Get the buffer if the format is SAMPLES_FLOAT
+	float* get_float();
+	int get_format();
+// Bytes in 1 sample of the format
+	static int get_sample_size(int format);
+// Copy len samples from the offset of src to the offset of this, 
+// converting the format.
+	void copy_from(Samples *src, int64_t len);
 // Get number of samples allocated
 	int get_allocated();
 	void set_allocated(int allocated);
@@ -61,8 +73,9 @@ public:
 
 private:
 	int shmid;
-	double *data;
+	void *data;
 	int allocated;
+	int format;
 // Offset to 1st sample in samples.
 	int offset;
 	int use_shm;
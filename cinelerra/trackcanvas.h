@@ -75,6 +75,14 @@ public:
 // User can either call draw or draw_overlays to copy a fresh 
 // canvas and just draw the overlays over it
 	void draw_overlays();
+// Mark a region as changed.  The next draw_overlays only composites the 
+// union of the damaged regions.  With no damage it composites everything.
+	void damage(int x, int y, int w, int h);
+	void damage_track(Track *track);
+// Damage the column at a position in seconds
+	void damage_position(double position);
+// Flash the region composited by the last draw_overlays
+	void flash_overlays(int flush);
 	void update_handles();
 // Convert edit coords to transition coords
 	void get_transition_coords(Transition *transition,
@@ -348,6 +356,10 @@ public:
 
 // Display hourglass if timer expired
 	void test_timer();
+// Overlaps the damaged region or there is no damage
+	int track_damaged(Track *track);
+// Damage the tracks of the keyframes being dragged
+	void damage_drag_autos();
 // get the relevant patchbay by traversing the panes
 //	Patchbay* get_patchbay();
 
@@ -356,6 +368,11 @@ public:
 	TimelinePane *pane;
 // Allows overlays to get redrawn without redrawing the resources
 	BC_Pixmap *background_pixmap;
+// Union of the regions damaged since the last draw_overlays
+	int damaged;
+	int damage_x1, damage_y1, damage_x2, damage_y2;
+// Region composited by the last draw_overlays
+	int overlay_x, overlay_y, overlay_w, overlay_h;
 	BC_Pixmap *transition_pixmap;
 //	EditHandles *edit_handles;
 //	TransitionHandles *transition_handles;
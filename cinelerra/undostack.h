@@ -22,11 +22,21 @@
 #ifndef UNDOSTACK_H
 #define UNDOSTACK_H
 
+#include "condition.inc"
 #include "linklist.h"
+#include "mutex.inc"
 #include "stringfile.inc"
+#include "thread.h"
+#include "undostack.inc"
+#include <stdint.h>
 
+// default number of entries
 #define UNDOLEVELS 500
-#define UNDO_KEY_INTERVAL 100
+// default memory for the entries
+#define UNDO_MEMORY 0x4000000
+// Most entries between key buffers.  This bounds the number of differences
+// an undo or redo applies.
+#define UNDO_KEY_INTERVAL 32
 
 // The undo stack is a series of key undo buffers and
 // incremental undo buffers.  The incremental buffers
@@ -35,6 +45,12 @@
 // a huge number of undo updates.
 
 
+// New entries are stored as full copies & the differences are computed
+// by the UndoCompressor thread, so editing doesn't wait for the diff.
+// Key & incremental buffers are stored compressed with zlib.
+// When they exceed the memory limit, the oldest are moved to a journal
+// file or deleted.
+
 // even numbered entries are the before entries
 // odd numbered entries are the after entries
 // redo loads an after entry
@@ -46,8 +62,9 @@ public:
 	UndoStackItem();
 	~UndoStackItem();
 
-// Must be inserted into the list before calling this, so it can get the
-// previous key buffer.
+// Must be inserted into the list before calling this.
+// Stores a full copy which the compressor thread later replaces with
+// the difference from the previous entry.
 	void set_data(const char *data);
 	void set_description(char *description);
 	void set_filename(const char *filename);
@@ -60,15 +77,15 @@ public:
 	char* get_data();
 	char* get_filename();
 	int has_data();
+// bytes stored in memory
 	int get_size();
 	int is_key();
 	uint64_t get_flags();
     int get_modified();
 	
 
-// Get pointer to incremental data for use in an apply_difference command.
-	char* get_incremental_data();
-	int get_incremental_size();
+// Decompress the key or incremental data in a newly allocated buffer.
+	char* get_incremental_data(int *size);
 
 	void set_creator(void *creator);
 	void* get_creator();
@@ -87,12 +104,38 @@ private:
 	
 // data after the modification for redos
 	char *data;
+// bytes in data
 	int data_size;
+// bytes after decompression
+	int raw_size;
+// offset in the journal or -1 if data is in memory
+	int64_t journal_offset;
 
 // pointer to the object which set this undo buffer
 	void *creator;
 
 	char *session_filename;
+
+// uncompressed full copy waiting for the compressor thread
+	int pending;
+// changes every time the data is replaced
+	int64_t serial;
+
+	friend class UndoStack;
+};
+
+
+class UndoCompressor : public Thread
+{
+public:
+	UndoCompressor(UndoStack *stack);
+	~UndoCompressor();
+
+	void run();
+
+	UndoStack *stack;
+	Condition *input_lock;
+	int done;
 };
 
 class UndoStack : public List<UndoStackItem>
@@ -115,8 +158,43 @@ public:
 	UndoStackItem* pull_next();
 
 	void dump();
+
+// Maximum entries, maximum bytes in memory & the directory for the journal.
+// Entries beyond the memory limit are deleted if journal_dir is 0.
+	void set_limits(int levels, int64_t memory_limit, const char *journal_dir);
+
+// Replace the oldest pending entry with a difference.
+// Return 0 if there were no pending entries.
+	int compress_next();
 	
 	UndoStackItem* current;
+// Recursive lock for the list & the entry data, shared with the compressor
+	Mutex *lock;
+	UndoCompressor *compressor;
+	int64_t serial;
+
+	int levels;
+	int64_t memory_limit;
+// bytes of compressed entry data in memory
+	int64_t memory_used;
+	int journal_fd;
+	int64_t journal_size;
+
+// Last decompressed entry.  Stepping to the next entry only
+// applies its difference to this.
+	UndoStackItem *cache_item;
+	int64_t cache_serial;
+	char *cache_data;
+	int cache_size;
+// Take ownership of the decompressed data for item
+	void set_cache(UndoStackItem *item, char *data, int size);
+
+private:
+// Delete the oldest before & after entries
+	int remove_oldest();
+	void remove_item(UndoStackItem *item);
+// Move or delete the oldest entries until they fit in the memory limit
+	void apply_limits();
 };
 
 #endif
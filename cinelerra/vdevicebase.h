@@ -56,6 +56,17 @@ public:
 	virtual int start_playback() { return 1; };
 	virtual int stop_playback() { return 1; };
 	virtual BC_Bitmap* get_bitmap() { return 0; };
+// Frames written but never shown
+	virtual int64_t get_dropped_frames() { return 0; };
+// Deviation of the next frame written from its scheduled time, in seconds.
+// Return 1 if the device measures the deviation when it shows the frame.
+	virtual int record_jitter(double error) { return 0; };
+// Sums of the deviations measured by the device
+	virtual void get_jitter(double *sum, double *squares, int64_t *count) 
+	{
+		*sum = *squares = 0;
+		*count = 0;
+	};
 // Most Linux video drivers don't work.
 // Called by KeepaliveThread when the device appears to be stuck.
 // Should restart the device if that's what it takes to get it to work.
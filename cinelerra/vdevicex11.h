@@ -22,10 +22,12 @@
 #define VDEVICEX11_H
 
 #include "canvas.inc"
+#include "condition.inc"
 #include "edl.inc"
 #include "guicast.h"
 #include "maskauto.inc"
 #include "maskautos.inc"
+#include "mutex.inc"
 #include "pluginclient.inc"
 #include "thread.h"
 #include "vdevicebase.h"
@@ -35,6 +37,22 @@
 // output_frame is a temporary converted to the device format
 #define BITMAP_TEMP    1
 
+// Temporaries for playback: 1 rendering, 1 waiting, 1 being presented
+#define X11_BUFFERS 3
+
+class VDeviceX11;
+
+// Converts & draws the temporaries while the next frame renders
+class VDeviceX11Presenter : public Thread
+{
+public:
+	VDeviceX11Presenter(VDeviceX11 *device);
+
+	void run();
+
+	VDeviceX11 *device;
+};
+
 class VDeviceX11 : public VDeviceBase
 {
 public:
@@ -54,6 +72,11 @@ public:
 	int output_visible();
 // After loading the bitmap with a picture, write it
 	int write_buffer(VFrame *output_frame, EDL *edl);
+// Frames replaced by newer frames before the presenter got to them
+	int64_t get_dropped_frames();
+// Deviation is measured when the frame is drawn
+	int record_jitter(double error);
+	void get_jitter(double *sum, double *squares, int64_t *count);
 
 
 //=========================== compositing stages ===============================
@@ -126,7 +149,21 @@ public:
 	void copy_frame(VFrame *dst, VFrame *src, int want_texture);
 
 private:
+	friend class VDeviceX11Presenter;
+
     void output_to_bitmap(VFrame *output_frame);
+// Draw the bitmap in the window
+	void draw_output();
+// Draw the frame rate & presentation statistics
+	void draw_fps();
+// Convert & draw the newest waiting temporary in the presenter thread
+	void present_frame();
+// Add the deviation of a frame when it's shown
+	void add_jitter(double error, int64_t write_time);
+// Temporary not waiting or being presented
+	VFrame* next_output_frame();
+	void delete_output_frames();
+	void stop_presenter();
 
 // Closest colormodel the hardware can do for playback.
 // Only used by VDeviceX11::new_output_buffer.  The value from File::get_best_colormodel
@@ -167,6 +204,32 @@ private:
     int is_rendering;
 // if we accessed the canvas successfully
     int is_open;
+
+// Temporaries for playback when the frames need conversion
+	VFrame *output_frames[X11_BUFFERS];
+	int use_presenter;
+// Indexes in output_frames or -1
+	int queued_frame;
+	int presenting_frame;
+	int last_written;
+	int presenter_done;
+	int64_t dropped_frames;
+// Deviation of the frame being written when it was written
+	int have_frame_error;
+	double frame_error;
+// Deviation of each temporary when it was written & the time it was 
+// written, in jitter_timer microseconds
+	int have_output_error[X11_BUFFERS];
+	double output_error[X11_BUFFERS];
+	int64_t output_time[X11_BUFFERS];
+	Timer jitter_timer;
+	double jitter_sum;
+	double jitter_squares;
+	int64_t jitter_count;
+	VDeviceX11Presenter *presenter;
+// Protects the indexes.  Always taken after the canvas lock.
+	Mutex *present_lock;
+	Condition *present_wait;
 };
 
 #endif
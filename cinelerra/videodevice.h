@@ -163,6 +163,12 @@ public:
 // Otherwise return it.
 	Channel* new_input_source(char *device_name);
 	BC_Bitmap* get_bitmap();
+// Frames written but never shown by the output device
+	int64_t get_dropped_frames();
+// Deviation of the next frame from its scheduled time.  Return 1 if the 
+// output device measures it when the frame is shown.
+	int record_jitter(double error);
+	void get_jitter(double *sum, double *squares, int64_t *count);
 
 // Used by all devices to cause fd's to be not copied in fork operations.
 	int set_cloexec_flag(int desc, int value);
@@ -24,10 +24,54 @@
 
 #include "arender.inc"
 #include "filethread.inc"     // RING_BUFFERS
+#include "loadbalance.h"
 #include "samples.inc"
 #include "timestretch.inc"
+#include "virtualanode.inc"
 #include "virtualconsole.h"
 
+
+class VirtualAConsole;
+class VirtualATrackEngine;
+
+// Render the tracks with no shared plugins or shared modules concurrently.
+// Each track is rendered to its own buffer & mixed in track order later.
+class VirtualATrackPackage : public LoadPackage
+{
+public:
+	VirtualATrackPackage();
+
+	VirtualANode *node;
+	Samples *output;
+// Result of rendering the node
+	int result;
+};
+
+class VirtualATrackUnit : public LoadClient
+{
+public:
+	VirtualATrackUnit(VirtualATrackEngine *server);
+
+	void process_package(LoadPackage *package);
+
+	VirtualATrackEngine *server;
+};
+
+class VirtualATrackEngine : public LoadServer
+{
+public:
+	VirtualATrackEngine(VirtualAConsole *console, int cpus);
+
+	void init_packages();
+	LoadClient* new_client();
+	LoadPackage* new_package();
+
+	VirtualAConsole *console;
+	int64_t len;
+	int64_t start_position;
+	double playhead_position;
+};
+
 class VirtualAConsole : public VirtualConsole
 {
 public:
@@ -57,6 +101,15 @@ public:
 // mixed into the device buffer.
 	Samples *output_temp;
 
+// Flag the exit nodes which can be rendered concurrently.  
+// Returns the number of them.
+	int get_parallel_nodes();
+// 1 for each exit node which is rendered by track_engine
+	ArrayList<int> parallel_nodes;
+// output of each exit node rendered by track_engine
+	ArrayList<Samples*> track_output;
+	VirtualATrackEngine *track_engine;
+
     TimeStretch *stretch[MAX_CHANNELS];
 
 	ARender *arender;
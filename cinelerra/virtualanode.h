@@ -50,11 +50,25 @@ public:
 
 // Called by VirtualAConsole::process_buffer to process exit_nodes.
 // read_data recurses down the tree.
+// If mix is 0, a module leaves the output in output_temp for mix to 
+// pan into the device buffers later.
 	int render(Samples *output_temp,
 		int64_t size,
 		int64_t start_position,
 		int64_t sample_rate,
-        double playhead_position);
+        double playhead_position,
+		int mix = 1);
+
+// Pan the output of a module into audio_out
+	void mix(Samples **audio_out,
+		Samples *output_temp,
+		int64_t len,
+		int64_t start_position,
+		int64_t sample_rate);
+
+// Largest absolute sample
+	static double get_peak(double *buffer, int64_t len);
+	static double get_peak(float *buffer, int64_t len);
 
 // Read data from whatever comes before this node.
 // Calls render in either the parent node or the module for the track.
@@ -78,14 +92,21 @@ private:
 		int64_t sample_rate,
         double playhead_position);
 
-	int render_fade(double *buffer,
+	int render_fade(Samples *buffer,
 					int64_t len,
 					int64_t input_position,
 					int64_t sample_rate,
 					Autos *autos,
 					int direction,
 					int use_nudge);
-	int render_pan(double *input,        // start of input fragment
+	double get_fade_gain(int64_t input_position,
+		int64_t sample_rate,
+		Autos *autos,
+		int direction,
+		FloatAuto* &previous,
+		FloatAuto* &next);
+	int render_pan(Samples *input,
+				int64_t input_offset,  // start of input fragment
 				double *output,        // start of output fragment
 				int64_t fragment_len,      // fragment length in input scale
 				int64_t input_position, // starting sample of input buffer in project
@@ -22,6 +22,7 @@
 #define COMMONRENDERTHREAD_H
 
 #include "arraylist.h"
+#include "attachmentpoint.inc"
 #include "commonrender.inc"
 #include "module.inc"
 #include "playabletracks.inc"
@@ -69,6 +70,10 @@ public:
 // If reconfiguration is coming up, truncate length and reset last_playback.
 	int test_reconfigure(int64_t position, 
 		int64_t &length);
+// Store the module attachments when the console is cached &
+// make them current again when it's reused.
+	void save_attachments();
+	void restore_attachments();
 
 
 	RenderEngine *renderengine;
@@ -128,6 +133,15 @@ public:
 
 
 	PlayableTracks *playable_tracks;
+
+// Configuration the nodes were built for.  From CommonRender::get_signature.
+	ArrayList<int> signature;
+// Attachments of every module & the nodes attached to them when the console
+// was cached.
+	ArrayList<AttachmentPoint*> saved_attachments;
+	ArrayList<int> saved_totals;
+	ArrayList<VirtualNode*> saved_plugins;
+	ArrayList<int> saved_plugin_totals;
 };
 
 
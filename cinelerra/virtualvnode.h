@@ -80,18 +80,25 @@ private:
 			VFrame *output,
 			int64_t start_position,  // Start of input fragment in project if forward.  End of input fragment if reverse.
 			double frame_rate,
-			int use_opengl);
+			int use_opengl,
+// Alpha scaling deferred from render_fade & render_mask
+			float fade = 1,
+			VFrame *mask = 0);
 
 	int render_fade(VFrame *output,        // start of output fragment
 			int64_t start_position,  // start of input fragment in project if forward / end of input fragment if reverse
 			double frame_rate, 
 			Autos *autos,
 			int direction,
-			int use_opengl);
+			int use_opengl,
+// If set, store the fade in it instead of applying it
+			float *fade = 0);
 
-	void render_mask(VFrame *output_temp,
+// Returns the mask for the projector to apply if apply is 0
+	VFrame* render_mask(VFrame *output_temp,
 		int64_t start_position_project,
-		int use_opengl);
+		int use_opengl,
+		int apply = 1);
 
 	FadeEngine *fader;
 	MaskEngine *masker;
@@ -122,6 +122,18 @@ private:
 // for getting actual framerate
 	int64_t framerate_counter;
 	Timer framerate_timer;
+// Flash the frame in realtime playback & measure its deviation from 
+// start_time
+	int flash_realtime(double start_time);
+// Publish the presentation statistics
+	void update_playback_stats();
+// Frames shown after their time ran out & frames skipped
+	int64_t late_frames;
+	int64_t dropped_frames;
+// Presentation time - scheduled time, on the audio clock
+	double jitter_sum;
+	double jitter_squares;
+	int64_t jitter_count;
 	int render_strategy;
 };
 
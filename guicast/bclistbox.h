@@ -410,6 +410,13 @@ private:
 		int *result = 0);
 	int get_icon_w(BC_ListBoxItem *item);
 	int get_icon_h(BC_ListBoxItem *item);
+// Create the icon from the icon_vframe if it doesn't exist
+	BC_Pixmap* get_item_icon(BC_ListBoxItem *item);
+// Text measurements are cached since they dominate the layout of large lists
+	int get_item_text_w(BC_ListBoxItem *item);
+	int get_item_text_h();
+// Index of the first item in the view if the items are in order
+	int get_first_visible(ArrayList<BC_ListBoxItem*> *data, int column);
 	int get_item_x(BC_ListBoxItem *item);
 	int get_item_y(BC_ListBoxItem *item);
 	int get_item_w(BC_ListBoxItem *item);
@@ -492,6 +499,11 @@ private:
 	int xposition;
 // dimensions of a row in the list
 	int row_height, row_ascent, row_descent;
+// Height of MEDIUMFONT text or -1 if it hasn't been measured
+	int text_h;
+// Positions increase with the item number so drawing can start at the
+// first visible item & stop after the last one.
+	int items_ordered;
 
 
 	int selection_mode;
@@ -54,6 +54,8 @@ public:
 	void set_text(const char *new_text);
 	char* get_text();
 	void set_icon(BC_Pixmap *icon);
+// If only the vframe is set, the listbox creates the icon when the item
+// is first drawn, so large lists don't create pixmaps for hidden items.
 	void set_icon_vframe(VFrame *icon_vframe);
 	BC_Pixmap* get_icon();
 	int get_icon_x();
@@ -95,6 +97,10 @@ private:
 
 	BC_Pixmap *icon;
 	VFrame *icon_vframe;
+// The listbox created the icon from icon_vframe when the item was first drawn
+	int icon_allocated;
+// Width of the text in MEDIUMFONT or -1 if it hasn't been measured
+	int text_w;
 // x and y position in listbox relative to top left
 // Different positions for icon mode and text mode are maintained
 	int icon_x, icon_y;
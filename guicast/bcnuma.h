@@ -0,0 +1,82 @@
+
+/*
+ * CINELERRA
+ * Copyright (C) 2008 Adam Williams <broadcast at earthling dot net>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ */
+
+#ifndef BCNUMA_H
+#define BCNUMA_H
+
+#include "bcnuma.inc"
+
+#include <stdint.h>
+
+// Page size policies for large VFrames
+#define BC_PAGES_NORMAL 0
+// Advise the kernel to back them with transparent huge pages
+#define BC_PAGES_TRANSPARENT 1
+// Take them from the reserved huge page pool, falling back to normal pages
+#define BC_PAGES_EXPLICIT 2
+
+// Placement policies for large VFrames & LoadServer threads
+#define BC_NUMA_DEFAULT 0
+// Pin the LoadServer clients to nodes.  Frames are placed by first touch.
+#define BC_NUMA_LOCAL 1
+// Pin the LoadServer clients to nodes & spread frames across all the nodes
+#define BC_NUMA_INTERLEAVE 2
+
+// VFrames smaller than this always use malloc
+#define BC_NUMA_THRESHOLD 0x200000
+#define BC_HUGE_PAGE_SIZE 0x200000
+#define BC_NUMA_MAX_NODES 64
+
+// Memory & thread placement for the frame processing.
+// The policies are taken from BC_Resources::vframe_huge_pages & vframe_numa.
+class BC_NUMA
+{
+public:
+	static int get_nodes();
+// Node a LoadServer client should run on or -1 if clients aren't pinned
+	static int get_client_node(int number);
+// Pin the calling thread to the CPUs of a node
+	static int bind_thread(int node);
+
+// If large private frames should be mapped by allocate instead of malloc
+	static int use_mmap();
+// Map frame data following the policies.
+// size is updated to the length which must be passed to release.
+	static unsigned char* allocate(long *size);
+	static void release(unsigned char *data, long size);
+// Extra shmget flags for a frame.  size is updated to the length to get.
+	static int shm_flags(long *size);
+// Apply the policies to memory which was just attached or mapped
+	static void advise(unsigned char *data, long size);
+
+// Print the policies, mapped bytes & kernel huge page & NUMA counters
+	static void dump();
+// Called once to read the topology
+	static void init();
+
+private:
+	static int total_nodes;
+	static int nodes[BC_NUMA_MAX_NODES];
+// Bytes currently mapped by allocate
+	static int64_t mapped_bytes;
+};
+
+#endif
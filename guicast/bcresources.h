@@ -36,6 +36,7 @@
 #include "bctheme.inc"
 #include "bcwindowbase.inc"
 #include "vframe.inc"
+#include "vframepool.inc"
 
 #include <X11/Xlib.h>
 
@@ -361,6 +362,11 @@ public:
 
 // Make VFrame use shm
 	int vframe_shm;
+// Temporary frames shared by the renderers
+	VFramePool *vframe_pool;
+// Page size & NUMA placement of large VFrames.  Defined in bcnuma.h
+	int vframe_huge_pages;
+	int vframe_numa;
 
 // Available display extensions
 	int use_shm;
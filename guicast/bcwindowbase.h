@@ -504,6 +504,9 @@ public:
 // Set the gc to opaque
 	void set_opaque();
 	void set_inverse();
+// Clip drawing to a rectangle until reset_clip
+	void set_clip(int x, int y, int w, int h);
+	void reset_clip();
 	void set_background(VFrame *bitmap);
 // Change the window title.  The title is translated internally.
 	void set_title(const char *text, int flush = 1);
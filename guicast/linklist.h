@@ -59,6 +59,8 @@ public:
 // references to list
 	TYPE *first;
 	TYPE *last;
+// Incremented whenever items are added or removed
+	int changes;
 };
 
 template<class TYPE>
@@ -78,6 +80,7 @@ template<class TYPE>
 List<TYPE>::List()
 {
 	last = first = 0;
+	changes = 0;
 }
 
 template<class TYPE>
@@ -154,6 +157,7 @@ TYPE* List<TYPE>::append()
 {
 	TYPE* current_item;
 
+	changes++;
 	if(!last)        // add first node
 	{
 		current_item = last = first = new TYPE;
@@ -177,6 +181,7 @@ TYPE* List<TYPE>::append(TYPE *new_item)
 {
 	TYPE* current_item;
 	
+	changes++;
 	if(!last)        // add first node
 	{
 		current_item = last = first = new_item;
@@ -208,6 +213,7 @@ TYPE* List<TYPE>::insert_before(TYPE *item, TYPE *new_item)
 	if(!item) return append(new_item);      // if item is null, append
 
 	TYPE* current_item = new_item;
+	changes++;
 
 	if(item == first) first = current_item;   // set *first
 
@@ -235,6 +241,7 @@ TYPE* List<TYPE>::insert_after(TYPE *item, TYPE *new_item)
 	if(!item) return append(new_item);      // if item is null, append
 
 	TYPE* current_item = new_item;
+	changes++;
 
 	if(item == last) last = current_item;   // set *last
 
@@ -313,6 +320,7 @@ void List<TYPE>::remove_pointer(ListItem<TYPE> *item)
 	if(!item) return;
 
 	item->owner = 0;
+	changes++;
 
 	if(item == last && item == first)
 	{
@@ -0,0 +1,165 @@
+
+/*
+ * CINELERRA
+ * Copyright (C) 2008 Adam Williams <broadcast at earthling dot net>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ */
+
+#ifndef LISTINDEX_H
+#define LISTINDEX_H
+
+#include "arraylist.h"
+#include "linklist.h"
+
+// Binary search over a List whose items are in order of a key.
+// Built when first used & rebuilt when items are added or removed or a
+// lookup finds keys changed since the index was built.  Every result is
+// checked against its neighbors in the list, so it's always the same item
+// a linear search would return as long as the list is in order.
+template<class TYPE, class KEY>
+class ListIndex
+{
+public:
+	ListIndex(List<TYPE> *list, KEY TYPE::*key);
+
+// Last item with key <= position, or key < position if !inclusive.
+// Same as searching from the last item.
+	TYPE* get_before(KEY position, int inclusive);
+// First item with key >= position, or key > position if !inclusive.
+// Same as searching from the first item.
+	TYPE* get_after(KEY position, int inclusive);
+// Force a rebuild on the next lookup
+	void reset();
+
+private:
+	void rebuild();
+// Number of items with key <= position or key < position
+	int count(KEY position, int inclusive);
+	static int before(KEY value, KEY position, int inclusive)
+	{
+		return inclusive ? value <= position : value < position;
+	}
+
+	List<TYPE> *list;
+	KEY TYPE::*key;
+	ArrayList<TYPE*> items;
+	ArrayList<KEY> keys;
+// List::changes when the index was built
+	int changes;
+	int built;
+};
+
+
+
+template<class TYPE, class KEY>
+ListIndex<TYPE, KEY>::ListIndex(List<TYPE> *list, KEY TYPE::*key)
+{
+	this->list = list;
+	this->key = key;
+	changes = 0;
+	built = 0;
+}
+
+template<class TYPE, class KEY>
+void ListIndex<TYPE, KEY>::reset()
+{
+	built = 0;
+}
+
+template<class TYPE, class KEY>
+void ListIndex<TYPE, KEY>::rebuild()
+{
+	items.remove_all();
+	keys.remove_all();
+	for(TYPE *current = list->first; current; current = current->next)
+	{
+		items.append(current);
+		keys.append(current->*key);
+	}
+	changes = list->changes;
+	built = 1;
+}
+
+template<class TYPE, class KEY>
+int ListIndex<TYPE, KEY>::count(KEY position, int inclusive)
+{
+	int low = 0;
+	int high = keys.size();
+	while(low < high)
+	{
+		int middle = (low + high) / 2;
+		if(before(keys.values[middle], position, inclusive))
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low;
+}
+
+template<class TYPE, class KEY>
+TYPE* ListIndex<TYPE, KEY>::get_before(KEY position, int inclusive)
+{
+	for(int pass = 0; pass < 2; pass++)
+	{
+		if(!built || changes != list->changes) rebuild();
+
+		int number = count(position, inclusive);
+		TYPE *result = number ? items.values[number - 1] : 0;
+		TYPE *next = result ? result->next : list->first;
+		if((!result || before(result->*key, position, inclusive)) &&
+			(!next || !before(next->*key, position, inclusive)))
+			return result;
+
+// Keys changed
+		built = 0;
+	}
+
+// Keys are out of order
+	TYPE *current;
+	for(current = list->last; 
+		current && !before(current->*key, position, inclusive); 
+		current = current->previous)
+		;
+	return current;
+}
+
+template<class TYPE, class KEY>
+TYPE* ListIndex<TYPE, KEY>::get_after(KEY position, int inclusive)
+{
+	for(int pass = 0; pass < 2; pass++)
+	{
+		if(!built || changes != list->changes) rebuild();
+
+		int number = count(position, !inclusive);
+		TYPE *result = number < items.size() ? items.values[number] : 0;
+		TYPE *previous = result ? result->previous : list->last;
+		if((!result || !before(result->*key, position, !inclusive)) &&
+			(!previous || before(previous->*key, position, !inclusive)))
+			return result;
+
+		built = 0;
+	}
+
+	TYPE *current;
+	for(current = list->first; 
+		current && before(current->*key, position, !inclusive); 
+		current = current->next)
+		;
+	return current;
+}
+
+#endif
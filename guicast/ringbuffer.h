@@ -0,0 +1,56 @@
+
+/*
+ * CINELERRA
+ * Copyright (C) 2024 Adam Williams <broadcast at earthling dot net>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ */
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <stdint.h>
+
+// Byte FIFO for exactly 1 writing thread & 1 reading thread.
+// Neither side takes a lock so a realtime thread never waits on the other
+// thread.  Callers poll get_used & get_free to throttle themselves.
+class RingBuffer
+{
+public:
+// size is rounded up to a power of 2
+	RingBuffer(int size);
+	~RingBuffer();
+
+// Called by the writing thread.  Returns the bytes written.
+	int write(const char *data, int size);
+	int get_free();
+// Called by the reading thread.  Returns the bytes read.
+	int read(char *data, int size);
+	int get_used();
+// Only when neither thread is running
+	void reset();
+	int get_size();
+
+private:
+	char *data;
+	int size;
+	int mask;
+// Total bytes written & read.  Only the owning thread stores to each.
+	int64_t head;
+	int64_t tail;
+};
+
+#endif
@@ -167,6 +167,8 @@ public:
 	int get_bytes_per_pixel();
 	long get_bytes_per_line();
 	int get_memory_type();
+// The data was allocated by this frame
+	int owns_data();
 
 
 
@@ -430,6 +432,8 @@ private:
 	int shmid;
 // Local setting for shm usage
 	int use_shm;
+// Length of the mapping if private data came from BC_NUMA::allocate
+	long mmap_size;
 // If not set by user, is calculated from color_model
 	long bytes_per_line;
 	int bytes_per_pixel;
@@ -0,0 +1,106 @@
+
+/*
+ * CINELERRA
+ * Copyright (C) 2008 Adam Williams <broadcast at earthling dot net>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ * 
+ */
+
+#ifndef VFRAMEPOOL_H
+#define VFRAMEPOOL_H
+
+#include "arraylist.h"
+#include "mutex.inc"
+#include "vframe.inc"
+#include "vframepool.inc"
+
+#include <stdint.h>
+
+// Most idle bytes kept before the least recently used buckets are freed
+#define VFRAMEPOOL_MAX_IDLE 0x20000000
+
+// Idle frames of 1 size, color model & memory type
+class VFramePoolBucket
+{
+public:
+	VFramePoolBucket(int w, int h, int color_model, int use_shm);
+	~VFramePoolBucket();
+
+	int w;
+	int h;
+	int color_model;
+	int use_shm;
+	int64_t age;
+	ArrayList<VFrame*> frames;
+};
+
+// Temporary frames used during rendering are borrowed from here instead of
+// being allocated & deleted every time the track size changes.
+// Once playback has touched every size it needs, no more frames are
+// allocated.
+class VFramePool
+{
+public:
+	VFramePool();
+	~VFramePool();
+
+// Get a frame from an idle bucket or allocate a new one.
+// The contents are undefined.
+	VFrame* get_frame(int w, 
+		int h, 
+		int color_model, 
+		int use_shm = 1);
+// Return a frame to the pool.  Frames not allocated by the pool are adopted.
+// NULL is ignored.
+	void put_frame(VFrame *frame);
+// Return frame if it doesn't match the arguments & get a matching one.
+// Replaces the delete & new VFrame sequence in the consumers.
+	VFrame* reuse_frame(VFrame *frame,
+		int w, 
+		int h, 
+		int color_model, 
+		int use_shm = 1);
+// Delete all the idle frames
+	void flush();
+
+// Bytes in all the frames lent & idle
+	int64_t get_total();
+// Most bytes ever in the pool
+	int64_t get_high_water();
+// Fraction of get_frame calls which didn't allocate
+	double get_hit_rate();
+	void reset_stats();
+	void dump();
+
+private:
+	VFramePoolBucket* get_bucket(int w, int h, int color_model, int use_shm);
+// Free the least recently used idle frames until the idle bytes fit
+	void shrink(VFramePoolBucket *keep);
+
+	Mutex *lock;
+	ArrayList<VFramePoolBucket*> buckets;
+// Frames currently lent out & their sizes when they were lent
+	ArrayList<VFrame*> lent;
+	ArrayList<int64_t> lent_sizes;
+	int64_t total;
+	int64_t idle;
+	int64_t high_water;
+	int64_t hits;
+	int64_t misses;
+	int64_t age;
+};
+
+#endif
@@ -88,9 +88,37 @@ static int x86_accel (void)
 }
 #endif
 
+#ifdef X86_64_CPU
+// The 32 bit MMX routines aren't built for x86_64 so only report SSE2 & AVX2
+static int x86_64_accel (void)
+{
+	int caps = 0;
+
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("sse2"))
+	{
+		caps |= ACCEL_X86_SSE2;
+		if(__builtin_cpu_supports("avx2"))
+			caps |= ACCEL_X86_AVX2;
+	}
+
+	return caps;
+}
+#endif
+
 int cpu_accel (void)
 {
-#ifdef X86_CPU
+#ifdef X86_64_CPU
+    static int got_accel = 0;
+    static int accel;
+
+    if (!got_accel) {
+	got_accel = 1;
+	accel = x86_64_accel ();
+    }
+
+    return accel;
+#elif defined(X86_CPU)
     static int got_accel = 0;
     static int accel;
 
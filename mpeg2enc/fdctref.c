@@ -31,6 +31,10 @@
 
 #include "config.h"
 
+#ifdef X86_64_CPU
+#include <emmintrin.h>
+#endif
+
 #ifndef PI
 # ifdef M_PI
 #  define PI M_PI
@@ -45,6 +49,9 @@ void fdct _ANSI_ARGS_((short *block));
 
 /* private data */
 static double c[8][8]; /* transform coefficients */
+#ifdef X86_64_CPU
+static double ct[8][8] __attribute__ ((aligned (16))); /* transposed c */
+#endif
 
 void init_fdct()
 {
@@ -58,6 +65,12 @@ void init_fdct()
     for (j=0; j<8; j++)
       c[i][j] = s * cos((PI/8.0)*i*(j+0.5));
   }
+
+#ifdef X86_64_CPU
+  for (i=0; i<8; i++)
+    for (j=0; j<8; j++)
+      ct[j][i] = c[i][j];
+#endif
 }
 
 void fdct(block)
@@ -118,3 +131,60 @@ short *block;
  */
       }
 }
+
+#ifdef X86_64_CPU
+/*
+ * SSE2 version of fdct.  Each lane does the same sequence of double
+ * precision operations as fdct, so the results are identical.
+ */
+void fdct_sse2(short *block)
+{
+	int i, k;
+	double tmp[64] __attribute__ ((aligned (16)));
+	double out[64] __attribute__ ((aligned (16)));
+	__m128d round = _mm_set1_pd(0.499999);
+
+	for(i = 0; i < 8; i++)
+	{
+		__m128d s0 = _mm_setzero_pd();
+		__m128d s1 = _mm_setzero_pd();
+		__m128d s2 = _mm_setzero_pd();
+		__m128d s3 = _mm_setzero_pd();
+		for(k = 0; k < 8; k++)
+		{
+			__m128d x = _mm_set1_pd(block[8 * i + k]);
+			s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_load_pd(&ct[k][0]), x));
+			s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_load_pd(&ct[k][2]), x));
+			s2 = _mm_add_pd(s2, _mm_mul_pd(_mm_load_pd(&ct[k][4]), x));
+			s3 = _mm_add_pd(s3, _mm_mul_pd(_mm_load_pd(&ct[k][6]), x));
+		}
+		_mm_store_pd(tmp + 8 * i + 0, s0);
+		_mm_store_pd(tmp + 8 * i + 2, s1);
+		_mm_store_pd(tmp + 8 * i + 4, s2);
+		_mm_store_pd(tmp + 8 * i + 6, s3);
+	}
+
+	for(i = 0; i < 8; i++)
+	{
+		__m128d s0 = _mm_setzero_pd();
+		__m128d s1 = _mm_setzero_pd();
+		__m128d s2 = _mm_setzero_pd();
+		__m128d s3 = _mm_setzero_pd();
+		for(k = 0; k < 8; k++)
+		{
+			__m128d x = _mm_set1_pd(c[i][k]);
+			s0 = _mm_add_pd(s0, _mm_mul_pd(x, _mm_load_pd(tmp + 8 * k + 0)));
+			s1 = _mm_add_pd(s1, _mm_mul_pd(x, _mm_load_pd(tmp + 8 * k + 2)));
+			s2 = _mm_add_pd(s2, _mm_mul_pd(x, _mm_load_pd(tmp + 8 * k + 4)));
+			s3 = _mm_add_pd(s3, _mm_mul_pd(x, _mm_load_pd(tmp + 8 * k + 6)));
+		}
+		_mm_store_pd(out + 8 * i + 0, _mm_add_pd(s0, round));
+		_mm_store_pd(out + 8 * i + 2, _mm_add_pd(s1, round));
+		_mm_store_pd(out + 8 * i + 4, _mm_add_pd(s2, round));
+		_mm_store_pd(out + 8 * i + 6, _mm_add_pd(s3, round));
+	}
+
+	for(i = 0; i < 64; i++)
+		block[i] = (int)floor(out[i]);
+}
+#endif
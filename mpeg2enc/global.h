@@ -403,6 +403,8 @@ EXTERN_ int quiet; /* suppress warnings */
 
 
 EXTERN_ pict_data_s cur_picture;
+/* Picture whose motion estimation runs while cur_picture is coded */
+EXTERN_ pict_data_s ahead_picture;
 
 /* reconstructed frames */
 EXTERN_ unsigned char *newrefframe[3], *oldrefframe[3], *auxframe[3];
@@ -583,6 +585,10 @@ void init_idct _ANSI_ARGS_((void));
 void motion_estimation _ANSI_ARGS_((pict_data_s *picture,
 	motion_comp_s *mc_data,
 	int secondfield, int ipflag));
+void motion_estimation_start _ANSI_ARGS_((pict_data_s *picture,
+	motion_comp_s *mc_data,
+	int secondfield, int ipflag));
+void motion_estimation_wait _ANSI_ARGS_((void));
 
 /* mpeg2enc.c */
 void error _ANSI_ARGS_((char *text));
@@ -623,6 +629,8 @@ void putmv _ANSI_ARGS_((slice_engine_t *engine, int dmv, int f_code));
 
 /* putpic.c */
 void putpict _ANSI_ARGS_((pict_data_s *picture));
+void putpict_start _ANSI_ARGS_((pict_data_s *picture));
+void putpict_finish _ANSI_ARGS_((pict_data_s *picture));
 
 /* putseq.c */
 void putseq _ANSI_ARGS_((void));
@@ -240,6 +240,7 @@ static int (*pdist2) (uint8_t *blk1, uint8_t *blk2,
 static int (*pbdist2) (uint8_t *pf, uint8_t *pb,
 					   uint8_t *p2, int lx, int hxf, int hyf, int hxb, int hyb, int h);
 
+static int (*pvariance) (uint8_t *mb, int size, int lx);
 static int (*pbdist1) (uint8_t *pf, uint8_t *pb,
 					   uint8_t *p2, int lx, int hxf, int hyf, int hxb, int hyb, int h);
 
@@ -351,8 +352,8 @@ int bidir_chrom_var_sum( mb_motion_s *lum_mc_f,
 
 static int chrom_var_sum( subsampled_mb_s *ssblk, int h, int lx )
 {
-	return (variance(ssblk->umb,(h>>1),(lx>>1)) + 
-			variance(ssblk->vmb,(h>>1),(lx>>1))) * 2;
+	return ((*pvariance)(ssblk->umb,(h>>1),(lx>>1)) + 
+			(*pvariance)(ssblk->vmb,(h>>1),(lx>>1))) * 2;
 }
 
 /*
@@ -2246,7 +2247,7 @@ static void frame_ME(motion_engine_t *engine,
 	   for sub-sampling.  Silly MPEG forcing chrom/lum to have same
 	   quantisations...
 	 */
-	var = variance(ssmb.mb,16,width);
+	var = (*pvariance)(ssmb.mb,16,width);
 
 //printf("motion %d\n", picture->pict_type);
 	if (picture->pict_type==I_TYPE)
@@ -2407,7 +2408,7 @@ static void frame_ME(motion_engine_t *engine,
 	{
 		if (picture->frame_pred_dct)
 		{
-			var = variance(ssmb.mb,16,width);
+			var = (*pvariance)(ssmb.mb,16,width);
 			/* forward */
 			fullsearch(engine, mc->oldorg[0],mc->oldref[0],&ssmb,
 					   width,i,j,mc->sxf,mc->syf,
@@ -2643,8 +2644,8 @@ static void field_ME(motion_engine_t *engine,
 		ssmb.qmb += (width >> 2);
 	}
 
-	var = variance(ssmb.mb,16,w2) + 
-		( variance(ssmb.umb,8,(width>>1)) + variance(ssmb.vmb,8,(width>>1)))*2;
+	var = (*pvariance)(ssmb.mb,16,w2) + 
+		( (*pvariance)(ssmb.umb,8,(width>>1)) + (*pvariance)(ssmb.vmb,8,(width>>1)))*2;
 
 	if (picture->pict_type==I_TYPE)
 		mbi->mb_type = MB_INTRA;
@@ -2915,6 +2916,7 @@ void init_motion()
 {
 	int cpucap = cpu_accel();
 
+	pvariance = variance;
 	if( cpucap  == 0 )	/* No MMX/SSE etc support available */
 	{
 		pdist22 = dist22;
@@ -2970,6 +2972,34 @@ void init_motion()
 		pmblock_sub44_dists = mblock_sub44_dists_mmx;
 	}
 #endif
+#ifdef X86_64_CPU
+	else if(cpucap & ACCEL_X86_SSE2)
+	{
+		if(verbose) fprintf( stderr, "SETTING SSE2 for MOTION!\n");
+		pdist22 = dist22_sse2;
+		pdist44 = dist44;
+		pdist1_00 = dist1_00_sse2;
+		pdist1_01 = dist1_01_sse2;
+		pdist1_10 = dist1_10_sse2;
+		pdist1_11 = dist1_11_sse2;
+		pbdist1 = bdist1_sse2;
+		pdist2 = dist2_sse2;
+		pbdist2 = bdist2_sse2;
+		pdist2_22 = dist2_22_sse2;
+		pbdist2_22 = bdist2_22_sse2;
+		pvariance = variance_sse2;
+		pfind_best_one_pel = find_best_one_pel;
+		pbuild_sub22_mcomps	= build_sub22_mcomps;
+
+		if(cpucap & ACCEL_X86_AVX2)
+		{
+			if(verbose) fprintf( stderr, "SETTING AVX2 for MOTION!\n");
+			pdist1_11 = dist1_11_avx2;
+			pbdist1 = bdist1_avx2;
+			pbdist2 = bdist2_avx2;
+		}
+	}
+#endif
 }
 
 
@@ -3028,7 +3058,11 @@ void motion_engine_loop(motion_engine_t *engine)
 }
 
 
-void motion_estimation(pict_data_s *picture,
+/*
+ * Start the motion engines on a picture and return without waiting.
+ * The picture and mc_data must stay valid until motion_estimation_wait.
+ */
+void motion_estimation_start(pict_data_s *picture,
 	motion_comp_s *mc_data,
 	int secondfield, int ipflag)
 {
@@ -3044,7 +3078,11 @@ void motion_estimation(pict_data_s *picture,
 		motion_engines[i].ipflag = ipflag;
 		pthread_mutex_unlock(&(motion_engines[i].input_lock));
 	}
+}
 
+void motion_estimation_wait()
+{
+	int i;
 /* Wait for completion */
 	for(i = 0; i < processors; i++)
 	{
@@ -3052,11 +3090,17 @@ void motion_estimation(pict_data_s *picture,
 	}
 }
 
+void motion_estimation(pict_data_s *picture,
+	motion_comp_s *mc_data,
+	int secondfield, int ipflag)
+{
+	motion_estimation_start(picture, mc_data, secondfield, ipflag);
+	motion_estimation_wait();
+}
+
 void start_motion_engines()
 {
 	int i;
-	int rows_per_processor = (int)((float)height2 / 16 / processors + 0.5);
-	int current_row = 0;
 	pthread_attr_t  attr;
 	pthread_mutexattr_t mutex_attr;
 
@@ -3065,10 +3109,9 @@ void start_motion_engines()
 	motion_engines = calloc(1, sizeof(motion_engine_t) * processors);
 	for(i = 0; i < processors; i++)
 	{
-		motion_engines[i].start_row = current_row * i * 16;
-		current_row += rows_per_processor;
-		if(current_row > height2 / 16) current_row = height2 / 16;
-		motion_engines[i].end_row = current_row * 16;
+/* Split the rows evenly so every row is covered */
+		motion_engines[i].start_row = height2 / 16 * i / processors * 16;
+		motion_engines[i].end_row = height2 / 16 * (i + 1) / processors * 16;
 		pthread_mutex_init(&(motion_engines[i].input_lock), &mutex_attr);
 		pthread_mutex_lock(&(motion_engines[i].input_lock));
 		pthread_mutex_init(&(motion_engines[i].output_lock), &mutex_attr);
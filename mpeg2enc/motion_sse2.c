@@ -0,0 +1,436 @@
+/*
+ * motion_sse2.c
+ *
+ * SSE2 & AVX2 versions of the motion estimation distance routines for
+ * x86_64, where the 32 bit MMX assembly can't be used.  These return
+ * exactly the same values as the C versions in motion.c, including
+ * the early termination of dist1_00.
+ *
+ * mpeg2enc is free software; you can redistribute new parts
+ * and/or modify under the terms of the GNU General Public License
+ * as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * mpeg2enc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <inttypes.h>
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#include "config.h"
+#include "global.h"
+#include "simd.h"
+
+#ifdef X86_64_CPU
+
+#define LOAD16(p) _mm_loadu_si128((const __m128i*)(p))
+#define LOAD8(p) _mm_loadl_epi64((const __m128i*)(p))
+
+/* Add the 2 halves of a psadbw result */
+static inline int sad_total(__m128i sad)
+{
+	return _mm_cvtsi128_si32(sad) +
+		_mm_cvtsi128_si32(_mm_srli_si128(sad, 8));
+}
+
+/* Add the 4 32 bit words */
+static inline int sum32(__m128i x)
+{
+	x = _mm_add_epi32(x, _mm_srli_si128(x, 8));
+	x = _mm_add_epi32(x, _mm_srli_si128(x, 4));
+	return _mm_cvtsi128_si32(x);
+}
+
+/* (a + b) >> 1 without the rounding of pavgb */
+static inline __m128i avg_trunc(__m128i a, __m128i b)
+{
+	return _mm_sub_epi8(_mm_avg_epu8(a, b),
+		_mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1)));
+}
+
+/* (a + b + c + d + round) >> 2 for 16 pels */
+static inline __m128i avg4(__m128i a, __m128i b, __m128i c, __m128i d, __m128i round)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(a, zero),
+			_mm_unpacklo_epi8(b, zero)),
+		_mm_add_epi16(_mm_unpacklo_epi8(c, zero),
+			_mm_unpacklo_epi8(d, zero)));
+	__m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(a, zero),
+			_mm_unpackhi_epi8(b, zero)),
+		_mm_add_epi16(_mm_unpackhi_epi8(c, zero),
+			_mm_unpackhi_epi8(d, zero)));
+	lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 2);
+	hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 2);
+	return _mm_packus_epi16(lo, hi);
+}
+
+/* Sum of squared differences of 16 pels in 4 32 bit words */
+static inline __m128i sqr_diff(__m128i a, __m128i b)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(a, zero),
+		_mm_unpacklo_epi8(b, zero));
+	__m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(a, zero),
+		_mm_unpackhi_epi8(b, zero));
+	return _mm_add_epi32(_mm_madd_epi16(lo, lo), _mm_madd_epi16(hi, hi));
+}
+
+int dist1_00_sse2(uint8_t *blk1, uint8_t *blk2, int lx, int h, int distlim)
+{
+	int s = 0;
+	int j;
+
+	for(j = 0; j < h; j++)
+	{
+		s += sad_total(_mm_sad_epu8(LOAD16(blk1), LOAD16(blk2)));
+		if(s >= distlim) break;
+		blk1 += lx;
+		blk2 += lx;
+	}
+	return s;
+}
+
+int dist1_01_sse2(uint8_t *blk1, uint8_t *blk2, int lx, int h)
+{
+	__m128i s = _mm_setzero_si128();
+	int j;
+
+	for(j = 0; j < h; j++)
+	{
+		__m128i p = avg_trunc(LOAD16(blk1), LOAD16(blk1 + 1));
+		s = _mm_add_epi64(s, _mm_sad_epu8(p, LOAD16(blk2)));
+		blk1 += lx;
+		blk2 += lx;
+	}
+	return sad_total(s);
+}
+
+int dist1_10_sse2(uint8_t *blk1, uint8_t *blk2, int lx, int h)
+{
+	__m128i s = _mm_setzero_si128();
+	__m128i row = LOAD16(blk1);
+	int j;
+
+	for(j = 0; j < h; j++)
+	{
+		__m128i next = LOAD16(blk1 + lx);
+		s = _mm_add_epi64(s, _mm_sad_epu8(avg_trunc(row, next), LOAD16(blk2)));
+		row = next;
+		blk1 += lx;
+		blk2 += lx;
+	}
+	return sad_total(s);
+}
+
+int dist1_11_sse2(uint8_t *blk1, uint8_t *blk2, int lx, int h)
+{
+	__m128i s = _mm_setzero_si128();
+	__m128i zero = _mm_setzero_si128();
+	int j;
+
+	for(j = 0; j < h; j++)
+	{
+		__m128i p = avg4(LOAD16(blk1),
+			LOAD16(blk1 + 1),
+			LOAD16(blk1 + lx),
+			LOAD16(blk1 + lx + 1),
+			zero);
+		s = _mm_add_epi64(s, _mm_sad_epu8(p, LOAD16(blk2)));
+		blk1 += lx;
+		blk2 += lx;
+	}
+	return sad_total(s);
+}
+
+int dist22_sse2(uint8_t *blk1, uint8_t *blk2, int flx, int fh)
+{
+	__m128i s = _mm_setzero_si128();
+	int j;
+
+	for(j = 0; j < fh; j++)
+	{
+		s = _mm_add_epi64(s, _mm_sad_epu8(LOAD8(blk1), LOAD8(blk2)));
+		blk1 += flx;
+		blk2 += flx;
+	}
+	return _mm_cvtsi128_si32(s);
+}
+
+int dist2_sse2(uint8_t *blk1, uint8_t *blk2, int lx, int hx, int hy, int h)
+{
+	__m128i s = _mm_setzero_si128();
+	__m128i two = _mm_set1_epi16(2);
+	int j;
+
+	for(j = 0; j < h; j++)
+	{
+		__m128i p;
+		if(!hx && !hy)
+			p = LOAD16(blk1);
+		else
+		if(hx && !hy)
+			p = _mm_avg_epu8(LOAD16(blk1), LOAD16(blk1 + 1));
+		else
+		if(!hx && hy)
+			p = _mm_avg_epu8(LOAD16(blk1), LOAD16(blk1 + lx));
+		else
+			p = avg4(LOAD16(blk1),
+				LOAD16(blk1 + 1),
+				LOAD16(blk1 + lx),
+				LOAD16(blk1 + lx + 1),
+				two);
+
+		s = _mm_add_epi32(s, sqr_diff(p, LOAD16(blk2)));
+		blk1 += lx;
+		blk2 += lx;
+	}
+	return sum32(s);
+}
+
+int dist2_22_sse2(uint8_t *blk1, uint8_t *blk2, int lx, int h)
+{
+	__m128i s = _mm_setzero_si128();
+	__m128i zero = _mm_setzero_si128();
+	int j;
+
+	for(j = 0; j < h; j++)
+	{
+		__m128i d = _mm_sub_epi16(_mm_unpacklo_epi8(LOAD8(blk1), zero),
+			_mm_unpacklo_epi8(LOAD8(blk2), zero));
+		s = _mm_add_epi32(s, _mm_madd_epi16(d, d));
+		blk1 += lx;
+		blk2 += lx;
+	}
+	return sum32(s);
+}
+
+int bdist2_22_sse2(uint8_t *blk1f, uint8_t *blk1b, uint8_t *blk2, int lx, int h)
+{
+	__m128i s = _mm_setzero_si128();
+	__m128i zero = _mm_setzero_si128();
+	int j;
+
+	for(j = 0; j < h; j++)
+	{
+		__m128i p = _mm_avg_epu8(LOAD8(blk1f), LOAD8(blk1b));
+		__m128i d = _mm_sub_epi16(_mm_unpacklo_epi8(p, zero),
+			_mm_unpacklo_epi8(LOAD8(blk2), zero));
+		s = _mm_add_epi32(s, _mm_madd_epi16(d, d));
+		blk1f += lx;
+		blk1b += lx;
+		blk2 += lx;
+	}
+	return sum32(s);
+}
+
+/* Bidirectional prediction of 16 pels */
+static inline __m128i bipred(uint8_t *pf, uint8_t *pfa, uint8_t *pfb, uint8_t *pfc,
+	uint8_t *pb, uint8_t *pba, uint8_t *pbb, uint8_t *pbc)
+{
+	__m128i two = _mm_set1_epi16(2);
+	__m128i f = avg4(LOAD16(pf), LOAD16(pfa), LOAD16(pfb), LOAD16(pfc), two);
+	__m128i b = avg4(LOAD16(pb), LOAD16(pba), LOAD16(pbb), LOAD16(pbc), two);
+	return _mm_avg_epu8(f, b);
+}
+
+int bdist1_sse2(uint8_t *pf, uint8_t *pb, uint8_t *p2, int lx,
+	int hxf, int hyf, int hxb, int hyb, int h)
+{
+	uint8_t *pfa = pf + hxf;
+	uint8_t *pfb = pf + lx * hyf;
+	uint8_t *pfc = pfb + hxf;
+	uint8_t *pba = pb + hxb;
+	uint8_t *pbb = pb + lx * hyb;
+	uint8_t *pbc = pbb + hxb;
+	__m128i s = _mm_setzero_si128();
+	int j, offset;
+
+	for(j = 0, offset = 0; j < h; j++, offset += lx)
+	{
+		__m128i p = bipred(pf + offset, pfa + offset, pfb + offset, pfc + offset,
+			pb + offset, pba + offset, pbb + offset, pbc + offset);
+		s = _mm_add_epi64(s, _mm_sad_epu8(p, LOAD16(p2 + offset)));
+	}
+	return sad_total(s);
+}
+
+int bdist2_sse2(uint8_t *pf, uint8_t *pb, uint8_t *p2, int lx,
+	int hxf, int hyf, int hxb, int hyb, int h)
+{
+	uint8_t *pfa = pf + hxf;
+	uint8_t *pfb = pf + lx * hyf;
+	uint8_t *pfc = pfb + hxf;
+	uint8_t *pba = pb + hxb;
+	uint8_t *pbb = pb + lx * hyb;
+	uint8_t *pbc = pbb + hxb;
+	__m128i s = _mm_setzero_si128();
+	int j, offset;
+
+	for(j = 0, offset = 0; j < h; j++, offset += lx)
+	{
+		__m128i p = bipred(pf + offset, pfa + offset, pfb + offset, pfc + offset,
+			pb + offset, pba + offset, pbb + offset, pbc + offset);
+		s = _mm_add_epi32(s, sqr_diff(p, LOAD16(p2 + offset)));
+	}
+	return sum32(s);
+}
+
+int variance_sse2(uint8_t *p, int size, int lx)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i s = _mm_setzero_si128();
+	__m128i s2 = _mm_setzero_si128();
+	unsigned int sum, sum2;
+	int j;
+
+	if(size == 16)
+	{
+		for(j = 0; j < size; j++)
+		{
+			__m128i row = LOAD16(p);
+			__m128i lo = _mm_unpacklo_epi8(row, zero);
+			__m128i hi = _mm_unpackhi_epi8(row, zero);
+			s = _mm_add_epi64(s, _mm_sad_epu8(row, zero));
+			s2 = _mm_add_epi32(s2,
+				_mm_add_epi32(_mm_madd_epi16(lo, lo), _mm_madd_epi16(hi, hi)));
+			p += lx;
+		}
+	}
+	else
+	if(size == 8 || size == 4)
+	{
+		for(j = 0; j < size; j++)
+		{
+			__m128i row = (size == 8) ? 
+				LOAD8(p) : 
+				_mm_cvtsi32_si128(*(uint32_t*)p);
+			__m128i lo = _mm_unpacklo_epi8(row, zero);
+			s = _mm_add_epi64(s, _mm_sad_epu8(row, zero));
+			s2 = _mm_add_epi32(s2, _mm_madd_epi16(lo, lo));
+			p += lx;
+		}
+	}
+	else
+	{
+		int i;
+		sum = sum2 = 0;
+		for(j = 0; j < size; j++)
+		{
+			for(i = 0; i < size; i++)
+			{
+				sum += p[i];
+				sum2 += p[i] * p[i];
+			}
+			p += lx;
+		}
+		return sum2 - (sum * sum) / (size * size);
+	}
+
+	sum = sad_total(s);
+	sum2 = sum32(s2);
+	return sum2 - (sum * sum) / (size * size);
+}
+
+
+/* The AVX2 versions handle all 16 pels of a row in 16 bit words */
+
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static inline __m256i widen(uint8_t *p)
+{
+	return _mm256_cvtepu8_epi16(LOAD16(p));
+}
+
+AVX2 static inline __m256i bipred_avx2(uint8_t *pf, uint8_t *pfa, uint8_t *pfb, uint8_t *pfc,
+	uint8_t *pb, uint8_t *pba, uint8_t *pbb, uint8_t *pbc)
+{
+	__m256i two = _mm256_set1_epi16(2);
+	__m256i one = _mm256_set1_epi16(1);
+	__m256i f = _mm256_add_epi16(_mm256_add_epi16(widen(pf), widen(pfa)),
+		_mm256_add_epi16(widen(pfb), widen(pfc)));
+	__m256i b = _mm256_add_epi16(_mm256_add_epi16(widen(pb), widen(pba)),
+		_mm256_add_epi16(widen(pbb), widen(pbc)));
+	f = _mm256_srli_epi16(_mm256_add_epi16(f, two), 2);
+	b = _mm256_srli_epi16(_mm256_add_epi16(b, two), 2);
+	return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(f, b), one), 1);
+}
+
+AVX2 static inline int sum32_avx2(__m256i x)
+{
+	return sum32(_mm_add_epi32(_mm256_castsi256_si128(x),
+		_mm256_extracti128_si256(x, 1)));
+}
+
+AVX2 int dist1_11_avx2(uint8_t *blk1, uint8_t *blk2, int lx, int h)
+{
+	__m256i s = _mm256_setzero_si256();
+	int j;
+
+	for(j = 0; j < h; j++)
+	{
+		__m256i p = _mm256_add_epi16(_mm256_add_epi16(widen(blk1), widen(blk1 + 1)),
+			_mm256_add_epi16(widen(blk1 + lx), widen(blk1 + lx + 1)));
+		p = _mm256_srli_epi16(p, 2);
+		s = _mm256_add_epi16(s, _mm256_abs_epi16(_mm256_sub_epi16(p, widen(blk2))));
+		blk1 += lx;
+		blk2 += lx;
+	}
+/* each word holds at most 16 * 255 */
+	return sum32_avx2(_mm256_madd_epi16(s, _mm256_set1_epi16(1)));
+}
+
+AVX2 int bdist1_avx2(uint8_t *pf, uint8_t *pb, uint8_t *p2, int lx,
+	int hxf, int hyf, int hxb, int hyb, int h)
+{
+	uint8_t *pfa = pf + hxf;
+	uint8_t *pfb = pf + lx * hyf;
+	uint8_t *pfc = pfb + hxf;
+	uint8_t *pba = pb + hxb;
+	uint8_t *pbb = pb + lx * hyb;
+	uint8_t *pbc = pbb + hxb;
+	__m256i s = _mm256_setzero_si256();
+	int j, offset;
+
+	for(j = 0, offset = 0; j < h; j++, offset += lx)
+	{
+		__m256i p = bipred_avx2(pf + offset, pfa + offset, pfb + offset, pfc + offset,
+			pb + offset, pba + offset, pbb + offset, pbc + offset);
+		s = _mm256_add_epi16(s,
+			_mm256_abs_epi16(_mm256_sub_epi16(p, widen(p2 + offset))));
+	}
+	return sum32_avx2(_mm256_madd_epi16(s, _mm256_set1_epi16(1)));
+}
+
+AVX2 int bdist2_avx2(uint8_t *pf, uint8_t *pb, uint8_t *p2, int lx,
+	int hxf, int hyf, int hxb, int hyb, int h)
+{
+	uint8_t *pfa = pf + hxf;
+	uint8_t *pfb = pf + lx * hyf;
+	uint8_t *pfc = pfb + hxf;
+	uint8_t *pba = pb + hxb;
+	uint8_t *pbb = pb + lx * hyb;
+	uint8_t *pbc = pbb + hxb;
+	__m256i s = _mm256_setzero_si256();
+	int j, offset;
+
+	for(j = 0, offset = 0; j < h; j++, offset += lx)
+	{
+		__m256i p = bipred_avx2(pf + offset, pfa + offset, pfb + offset, pfc + offset,
+			pb + offset, pba + offset, pbb + offset, pbc + offset);
+		__m256i d = _mm256_sub_epi16(p, widen(p2 + offset));
+		s = _mm256_add_epi32(s, _mm256_madd_epi16(d, d));
+	}
+	return sum32_avx2(s);
+}
+
+#endif
@@ -307,6 +307,12 @@ static void init()
 
 	cur_picture.blocks =
 		(int16_t (*)[64])bufalloc(mb_per_pict * block_count * sizeof(int16_t [64]));
+
+/* The look ahead picture shares the block data.  Only the macroblock
+   side information is written by motion estimation. */
+	ahead_picture = cur_picture;
+	ahead_picture.mbinfo = (
+		struct mbinfo *)bufalloc(mb_per_pict*sizeof(struct mbinfo));
   
   
 /* open statistics output file */
@@ -60,6 +60,12 @@ static void pred_comp_mmx(
 	uint8_t *src, uint8_t *dst,
 	int lx, int w, int h, int x, int y, int dx, int dy, int addflag);
 #endif
+#ifdef X86_64_CPU
+static void pred_comp_sse2(
+	pict_data_s *picture,
+	uint8_t *src, uint8_t *dst,
+	int lx, int w, int h, int x, int y, int dx, int dy, int addflag);
+#endif
 static void calc_DMV 
 	(	pict_data_s *picture,int DMV[][2], 
 		int *dmvector, int mvx, int mvy);
@@ -98,6 +104,13 @@ void init_predict_hv()
 		if(verbose) fprintf( stderr, "SETTING MMX for PREDICTION!\n");
 		ppred_comp = pred_comp_mmx;
 	}
+#endif
+#ifdef X86_64_CPU
+	else if(cpucap & ACCEL_X86_SSE2 )
+	{
+		if(verbose) fprintf( stderr, "SETTING SSE2 for PREDICTION!\n");
+		ppred_comp = pred_comp_sse2;
+	}
 #endif
     else
 	{
@@ -612,6 +625,54 @@ static void pred_comp_mmx(
 }
 #endif
 
+#ifdef X86_64_CPU
+static void pred_comp_sse2(
+	pict_data_s *picture,
+	uint8_t *src,
+	uint8_t *dst,
+	int lx,
+	int w, int h,
+	int x, int y,
+	int dx, int dy,
+	int addflag)
+{
+	int xint, xh, yint, yh;
+	uint8_t *s, *d;
+
+	/* only whole rows of 16 or 8 pels are vectorized */
+	if(w != 16 && w != 8)
+	{
+		pred_comp(picture, src, dst, lx, w, h, x, y, dx, dy, addflag);
+		return;
+	}
+
+	/* half pel scaling */
+	xint = dx>>1; /* integer part */
+	xh = dx & 1;  /* half pel flag */
+	yint = dy>>1;
+	yh = dy & 1;
+
+	/* origins */
+	s = src + lx*(y+yint) + (x+xint); /* motion vector */
+	d = dst + lx*y + x;
+
+	if( xh )
+	{
+		if( yh ) 
+			predcomp_11_sse2(s,d,lx,w,h,addflag);
+		else /* !yh */
+			predcomp_10_sse2(s,d,lx,w,h,addflag);
+	}
+	else /* !xh */
+	{
+		if( yh ) 
+			predcomp_01_sse2(s,d,lx,w,h,addflag);
+		else /* !yh */
+			predcomp_00_sse2(s,d,lx,w,h,addflag);
+	}
+}
+#endif
+
 /* calculate derived motion vectors (DMV) for dual prime prediction
  * dmvector[2]: differential motion vectors (-1,0,+1)
  * mvx,mvy: motion vector (for same parity)
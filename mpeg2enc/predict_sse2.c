@@ -0,0 +1,164 @@
+/*
+ * predict_sse2.c
+ *
+ * SSE2 versions of the motion compensated prediction and the
+ * prediction add/subtract for x86_64.  The results are identical to
+ * pred_comp in predict.c and add_pred, sub_pred in transfrm.c.
+ *
+ * mpeg2enc is free software; you can redistribute new parts
+ * and/or modify under the terms of the GNU General Public License
+ * as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * mpeg2enc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <inttypes.h>
+#include <emmintrin.h>
+
+#include "config.h"
+#include "global.h"
+#include "simd.h"
+
+#ifdef X86_64_CPU
+
+#define LOAD16(p) _mm_loadu_si128((const __m128i*)(p))
+#define LOAD8(p) _mm_loadl_epi64((const __m128i*)(p))
+#define STORE16(p, x) _mm_storeu_si128((__m128i*)(p), x)
+#define STORE8(p, x) _mm_storel_epi64((__m128i*)(p), x)
+
+/* (a + b + c + d + 2) >> 2 for 16 pels */
+static inline __m128i avg4(__m128i a, __m128i b, __m128i c, __m128i d)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i two = _mm_set1_epi16(2);
+	__m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(a, zero),
+			_mm_unpacklo_epi8(b, zero)),
+		_mm_add_epi16(_mm_unpacklo_epi8(c, zero),
+			_mm_unpacklo_epi8(d, zero)));
+	__m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(a, zero),
+			_mm_unpackhi_epi8(b, zero)),
+		_mm_add_epi16(_mm_unpackhi_epi8(c, zero),
+			_mm_unpackhi_epi8(d, zero)));
+	lo = _mm_srli_epi16(_mm_add_epi16(lo, two), 2);
+	hi = _mm_srli_epi16(_mm_add_epi16(hi, two), 2);
+	return _mm_packus_epi16(lo, hi);
+}
+
+/*
+ * Store 1 row of a prediction, averaging it with the destination if
+ * addflag.  The width is 16 or 8.
+ */
+static inline void store_row(uint8_t *d, __m128i p, int w, int addflag)
+{
+	if(w == 16)
+	{
+		if(addflag) p = _mm_avg_epu8(p, LOAD16(d));
+		STORE16(d, p);
+	}
+	else
+	{
+		if(addflag) p = _mm_avg_epu8(p, LOAD8(d));
+		STORE8(d, p);
+	}
+}
+
+/* Load 16 pels or 8 pels depending on the width */
+static inline __m128i load_row(uint8_t *s, int w)
+{
+	return (w == 16) ? LOAD16(s) : LOAD8(s);
+}
+
+void predcomp_00_sse2(uint8_t *src, uint8_t *dst, int lx, int w, int h, int addflag)
+{
+	int j;
+	for(j = 0; j < h; j++)
+	{
+		store_row(dst, load_row(src, w), w, addflag);
+		src += lx;
+		dst += lx;
+	}
+}
+
+/* vertical half pel */
+void predcomp_01_sse2(uint8_t *src, uint8_t *dst, int lx, int w, int h, int addflag)
+{
+	int j;
+	for(j = 0; j < h; j++)
+	{
+		__m128i p = _mm_avg_epu8(load_row(src, w), load_row(src + lx, w));
+		store_row(dst, p, w, addflag);
+		src += lx;
+		dst += lx;
+	}
+}
+
+/* horizontal half pel */
+void predcomp_10_sse2(uint8_t *src, uint8_t *dst, int lx, int w, int h, int addflag)
+{
+	int j;
+	for(j = 0; j < h; j++)
+	{
+		__m128i p = _mm_avg_epu8(load_row(src, w), load_row(src + 1, w));
+		store_row(dst, p, w, addflag);
+		src += lx;
+		dst += lx;
+	}
+}
+
+void predcomp_11_sse2(uint8_t *src, uint8_t *dst, int lx, int w, int h, int addflag)
+{
+	int j;
+	for(j = 0; j < h; j++)
+	{
+		__m128i p = avg4(load_row(src, w),
+			load_row(src + 1, w),
+			load_row(src + lx, w),
+			load_row(src + lx + 1, w));
+		store_row(dst, p, w, addflag);
+		src += lx;
+		dst += lx;
+	}
+}
+
+/* add prediction and prediction error, saturate to 0...255 */
+void add_pred_sse2(uint8_t *pred, uint8_t *cur, int lx, int16_t *blk)
+{
+	__m128i zero = _mm_setzero_si128();
+	int j;
+	for(j = 0; j < 8; j++)
+	{
+		__m128i p = _mm_unpacklo_epi8(LOAD8(pred), zero);
+		__m128i x = _mm_add_epi16(p, LOAD16(blk));
+		STORE8(cur, _mm_packus_epi16(x, x));
+		blk += 8;
+		cur += lx;
+		pred += lx;
+	}
+}
+
+/* subtract prediction from block data */
+void sub_pred_sse2(uint8_t *pred, uint8_t *cur, int lx, int16_t *blk)
+{
+	__m128i zero = _mm_setzero_si128();
+	int j;
+	for(j = 0; j < 8; j++)
+	{
+		__m128i c = _mm_unpacklo_epi8(LOAD8(cur), zero);
+		__m128i p = _mm_unpacklo_epi8(LOAD8(pred), zero);
+		STORE16(blk, _mm_sub_epi16(c, p));
+		blk += 8;
+		cur += lx;
+		pred += lx;
+	}
+}
+
+#endif
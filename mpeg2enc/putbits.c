@@ -72,29 +72,24 @@ void slice_putc(slice_engine_t *engine, unsigned char c)
 	engine->slice_buffer[engine->slice_size++] = c;
 }
 
+/* write rightmost n (0<=n<=32) bits of val to the slice buffer */
 void slice_putbits(slice_engine_t *engine, long val, int n)
 {
-	int i;
-	unsigned int mask;
-
-	mask = 1 << (n - 1); /* selects first (leftmost) bit */
-
-	for(i = 0; i < n; i++)
+/* Fill the partial byte and write whole bytes */
+	while(n >= engine->outcnt)
 	{
-    	engine->outbfr <<= 1;
-
-    	if(val & mask)
-    		engine->outbfr |= 1;
-
-    	mask >>= 1; /* select next bit */
-    	engine->outcnt--;
+		n -= engine->outcnt;
+		slice_putc(engine, 
+			(engine->outbfr << engine->outcnt) | 
+			((val >> n) & ((1 << engine->outcnt) - 1)));
+		engine->outbfr = 0;
+		engine->outcnt = 8;
+	}
 
-    	if(engine->outcnt == 0) /* 8 bit buffer full */
-    	{
-    		slice_putc(engine, engine->outbfr);
-    		engine->outcnt = 8;
-			engine->outbfr = 0;
-    	}
+	if(n > 0)
+	{
+		engine->outbfr = (engine->outbfr << n) | (val & ((1 << n) - 1));
+		engine->outcnt -= n;
 	}
 }
 
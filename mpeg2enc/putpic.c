@@ -419,10 +419,15 @@ void* slice_engine_loop(slice_engine_t *engine)
 }
 
 
-/* quantization / variable length encoding of a complete picture */
-void putpict(pict_data_s *picture)
+/*
+ * Write the picture header and start the slice engines on the
+ * quantization / variable length encoding of a complete picture.
+ * Returns without waiting so the caller can overlap other work with
+ * the slices.
+ */
+void putpict_start(pict_data_s *picture)
 {
-	int i, prev_mquant;
+	int i;
 
 	for(i = 0; i < processors; i++)
 	{
@@ -445,6 +450,16 @@ void putpict(pict_data_s *picture)
 
 		pthread_mutex_unlock(&(slice_engines[i].input_lock));
 	}
+}
+
+/*
+ * Wait for the slice engines and concatenate their buffers in row order.
+ * The rate control update happens in the same order as the serial encoder
+ * so the output doesn't depend on thread timing.
+ */
+void putpict_finish(pict_data_s *picture)
+{
+	int i;
 
 /* Wait for completion and write slices */
 	for(i = 0; i < processors; i++)
@@ -457,11 +472,16 @@ void putpict(pict_data_s *picture)
 		ratectl_update_pict(ratectl[i], picture);
 }
 
+/* quantization / variable length encoding of a complete picture */
+void putpict(pict_data_s *picture)
+{
+	putpict_start(picture);
+	putpict_finish(picture);
+}
+
 void start_slice_engines()
 {
 	int i;
-	int rows_per_processor = (int)((float)mb_height2 / processors + 0.5);
-	int current_row = 0;
 	pthread_attr_t attr;
 	pthread_mutexattr_t mutex_attr;
 
@@ -472,10 +492,8 @@ void start_slice_engines()
 	slice_engines = calloc(1, sizeof(slice_engine_t) * processors);
 	for(i = 0; i < processors; i++)
 	{
-		slice_engines[i].start_row = current_row;
-		current_row += rows_per_processor;
-		if(current_row > mb_height2) current_row = mb_height2;
-		slice_engines[i].end_row = current_row;
+		slice_engines[i].start_row = mb_height2 * i / processors;
+		slice_engines[i].end_row = mb_height2 * (i + 1) / processors;
 		
 		pthread_mutex_init(&(slice_engines[i].input_lock), &mutex_attr);
 		pthread_mutex_lock(&(slice_engines[i].input_lock));
@@ -33,15 +33,220 @@
 #include "global.h"
 
 
+/* A picture in coding order from frame reading to coding */
+typedef struct
+{
+	pict_data_s *picture;
+	motion_comp_s mc_data;
+/* frame number in display order */
+	int f;
+/* GOP header to write before the picture */
+	int gop_start;
+	int f0, np, nb, closed_gop;
+} seq_pict_t;
+
+/* search ranges carried between pictures */
+static int sxf = 0, sxb = 0, syf = 0, syb = 0;
+
+
+/*
+ * Set up picture i in coding order, read its frame and for frame
+ * pictures start the motion search.  The GOP header isn't written here
+ * because the previous picture may still be coding.
+ * Returns 0 if the input ended.
+ */
+static int start_picture(int i, seq_pict_t *seq)
+{
+	pict_data_s *picture = seq->picture;
+	motion_comp_s *mc_data = &seq->mc_data;
+	int j, f, f0, n, np, nb;
+
+	/* f0: lowest frame number in current GOP
+	 *
+	 * first GOP contains N-(M-1) frames,
+	 * all other GOPs contain N frames
+	 */
+	f0 = N*((i+(M-1))/N) - (M-1);
+
+	if (f0<0)
+		f0=0;
+
+	seq->gop_start = 0;
+	if(i == 0 || (i - 1) % M == 0)
+	{
+
+		/* I or P frame: Somewhat complicated buffer handling.
+		   The original reference frame data is actually held in
+		   the frame input buffers.  In input read-ahead buffer
+		   management code worries about rotating them for use.
+		   So to make the new old one the current new one we
+		   simply move the pointers.  However for the
+		   reconstructed "ref" data we are managing our a seperate
+		   pair of buffers. We need to swap these to avoid losing
+		   one!  */
+
+		for (j=0; j<3; j++)
+		{
+			unsigned char *tmp;
+			oldorgframe[j] = neworgframe[j];
+			tmp = oldrefframe[j];
+			oldrefframe[j] = newrefframe[j];
+			newrefframe[j] = tmp;
+		}
+
+		/* For an I or P frame the "current frame" is simply an alias
+		   for the new new reference frame. Saves the need to copy
+		   stuff around once the frame has been processed.
+		*/
+
+		picture->curorg = neworgframe;
+		picture->curref = newrefframe;
+
+
+		/* f: frame number in display order */
+		f = (i==0) ? 0 : i+M-1;
+		if (f>=end_frame)
+			f = end_frame - 1;
+
+		if (i==f0) /* first displayed frame in GOP is I */
+		{
+			/* I frame */
+			picture->pict_type = I_TYPE;
+
+			picture->forw_hor_f_code = 
+				picture->forw_vert_f_code = 15;
+			picture->back_hor_f_code = 
+				picture->back_vert_f_code = 15;
+
+			/* n: number of frames in current GOP
+			 *
+			 * first GOP contains (M-1) less (B) frames
+			 */
+			n = (i==0) ? N-(M-1) : N;
+
+			/* last GOP may contain less frames */
+			if (n > end_frame-f0)
+				n = end_frame-f0;
+
+			/* number of P frames */
+			if (i==0)
+				np = (n + 2*(M-1))/M - 1; /* first GOP */
+			else
+				np = (n + (M-1))/M - 1;
+
+			/* number of B frames */
+			nb = n - np - 1;
+
+			/* set closed_GOP in first GOP only */
+			seq->gop_start = 1;
+			seq->f0 = f0;
+			seq->np = np;
+			seq->nb = nb;
+			seq->closed_gop = (i == 0);
+		}
+		else
+		{
+			/* P frame */
+			picture->pict_type = P_TYPE;
+			picture->forw_hor_f_code = motion_data[0].forw_hor_f_code;
+			picture->forw_vert_f_code = motion_data[0].forw_vert_f_code;
+			picture->back_hor_f_code = 
+				picture->back_vert_f_code = 15;
+			sxf = motion_data[0].sxf;
+			syf = motion_data[0].syf;
+		}
+	}
+	else
+	{
+		/* B frame: no need to change the reference frames.
+		   The current frame data pointers are a 3rd set
+		   seperate from the reference data pointers.
+		*/
+		picture->curorg = auxorgframe;
+		picture->curref = auxframe;
+
+		/* f: frame number in display order */
+		f = i - 1;
+		picture->pict_type = B_TYPE;
+		n = (i-2)%M + 1; /* first B: n=1, second B: n=2, ... */
+		picture->forw_hor_f_code = motion_data[n].forw_hor_f_code;
+		picture->forw_vert_f_code = motion_data[n].forw_vert_f_code;
+		picture->back_hor_f_code = motion_data[n].back_hor_f_code;
+		picture->back_vert_f_code = motion_data[n].back_vert_f_code;
+		sxf = motion_data[n].sxf;
+		syf = motion_data[n].syf;
+		sxb = motion_data[n].sxb;
+		syb = motion_data[n].syb;
+	}
+
+	seq->f = f;
+	picture->temp_ref = f - f0;
+	picture->frame_pred_dct = frame_pred_dct_tab[picture->pict_type - 1];
+	picture->q_scale_type = qscale_tab[picture->pict_type - 1];
+	picture->intravlc = intravlc_tab[picture->pict_type - 1];
+	picture->altscan = altscan_tab[picture->pict_type - 1];
+
+	readframe(f + frame0, picture->curorg);
+	if(!frames_scaled) return 0;
+
+	mc_data->oldorg = oldorgframe;
+	mc_data->neworg = neworgframe;
+	mc_data->oldref = oldrefframe;
+	mc_data->newref = newrefframe;
+	mc_data->cur    = picture->curorg;
+	mc_data->curref = picture->curref;
+	mc_data->sxf = sxf;
+	mc_data->syf = syf;
+	mc_data->sxb = sxb;
+	mc_data->syb = syb;
+
+	if(!fieldpic)
+	{
+		picture->pict_struct = FRAME_PICTURE;
+/* A.Stevens 2000: Append fast motion compensation data for new frame */
+		fast_motion_data(picture->curorg[0], picture->pict_struct);
+
+/* do motion_estimation
+ *
+ * uses source frames (...orgframe) for full pel search
+ * and reconstructed frames (...refframe) for half pel search
+ */
+		motion_estimation_start(picture, mc_data, 0, 0);
+	}
+
+	return 1;
+}
+
+/* Write the GOP header which precedes the picture */
+static void put_gop(seq_pict_t *seq)
+{
+	int k;
 
+	if(!seq->gop_start) return;
+
+	for(k = 0; k < processors; k++)
+		ratectl_init_GOP(ratectl[k], seq->np, seq->nb);
+
+	/* No need for per-GOP seqhdr in first GOP as one
+	   has already been created.
+	 */
+	if(seq_header_every_gop) putseqhdr();
+	putgophdr(seq->f0, seq->closed_gop);
+}
 
 void putseq()
 {
 	/* this routine assumes (N % M) == 0 */
-	int i, j, k, f, f0, n, np, nb;
+	int i, k;
 	int ipflag;
-	int sxf = 0, sxb = 0, syf = 0, syb = 0;
-	motion_comp_s mc_data;
+	seq_pict_t seq[2];
+	seq_pict_t *current = &seq[0], *ahead = &seq[1], *tmp;
+	pict_data_s *picture;
+	int started = 0;
+
+	sxf = sxb = syf = syb = 0;
+	seq[0].picture = &cur_picture;
+	seq[1].picture = &ahead_picture;
 
 	for(k = 0; k < processors; k++)
 		ratectl_init_seq(ratectl[k]); /* initialize rate control */
@@ -89,179 +294,42 @@ void putseq()
 		}
 		fflush(stderr);
 
-		/* f0: lowest frame number in current GOP
-		 *
-		 * first GOP contains N-(M-1) frames,
-		 * all other GOPs contain N frames
-		 */
-		f0 = N*((i+(M-1))/N) - (M-1);
-
-		if (f0<0)
-			f0=0;
-
-		if(i == 0 || (i - 1) % M == 0)
-		{
-
-			/* I or P frame: Somewhat complicated buffer handling.
-			   The original reference frame data is actually held in
-			   the frame input buffers.  In input read-ahead buffer
-			   management code worries about rotating them for use.
-			   So to make the new old one the current new one we
-			   simply move the pointers.  However for the
-			   reconstructed "ref" data we are managing our a seperate
-			   pair of buffers. We need to swap these to avoid losing
-			   one!  */
-
-			for (j=0; j<3; j++)
-			{
-				unsigned char *tmp;
-				oldorgframe[j] = neworgframe[j];
-				tmp = oldrefframe[j];
-				oldrefframe[j] = newrefframe[j];
-				newrefframe[j] = tmp;
-			}
-
-			/* For an I or P frame the "current frame" is simply an alias
-			   for the new new reference frame. Saves the need to copy
-			   stuff around once the frame has been processed.
-			*/
-
-			cur_picture.curorg = neworgframe;
-			cur_picture.curref = newrefframe;
-//printf("putseq 1 %p %p %p\n", curorg[0], curorg[1], curorg[2]);
-
-
-			/* f: frame number in display order */
-			f = (i==0) ? 0 : i+M-1;
-			if (f>=end_frame)
-				f = end_frame - 1;
-
-			if (i==f0) /* first displayed frame in GOP is I */
-			{
-				/* I frame */
-				cur_picture.pict_type = I_TYPE;
-
-				cur_picture.forw_hor_f_code = 
-					cur_picture.forw_vert_f_code = 15;
-				cur_picture.back_hor_f_code = 
-					cur_picture.back_vert_f_code = 15;
-
-				/* n: number of frames in current GOP
-				 *
-				 * first GOP contains (M-1) less (B) frames
-				 */
-				n = (i==0) ? N-(M-1) : N;
-
-				/* last GOP may contain less frames */
-				if (n > end_frame-f0)
-					n = end_frame-f0;
-
-				/* number of P frames */
-				if (i==0)
-					np = (n + 2*(M-1))/M - 1; /* first GOP */
-				else
-					np = (n + (M-1))/M - 1;
-
-				/* number of B frames */
-				nb = n - np - 1;
-
-				for(k = 0; k < processors; k++)
-					ratectl_init_GOP(ratectl[k], np, nb);
-				
-				/* set closed_GOP in first GOP only 
-				   No need for per-GOP seqhdr in first GOP as one
-				   has already been created.
-				 */
-//				putgophdr(f0,i==0, i!=0 && seq_header_every_gop);
-				if(seq_header_every_gop) putseqhdr();
-				putgophdr(f0, i == 0);
-			}
-			else
-			{
-				/* P frame */
-				cur_picture.pict_type = P_TYPE;
-				cur_picture.forw_hor_f_code = motion_data[0].forw_hor_f_code;
-				cur_picture.forw_vert_f_code = motion_data[0].forw_vert_f_code;
-				cur_picture.back_hor_f_code = 
-					cur_picture.back_vert_f_code = 15;
-				sxf = motion_data[0].sxf;
-				syf = motion_data[0].syf;
-			}
-		}
-		else
-		{
-			/* B frame: no need to change the reference frames.
-			   The current frame data pointers are a 3rd set
-			   seperate from the reference data pointers.
-			*/
-			cur_picture.curorg = auxorgframe;
-			cur_picture.curref = auxframe;
-
-			/* f: frame number in display order */
-			f = i - 1;
-			cur_picture.pict_type = B_TYPE;
-			n = (i-2)%M + 1; /* first B: n=1, second B: n=2, ... */
-			cur_picture.forw_hor_f_code = motion_data[n].forw_hor_f_code;
-			cur_picture.forw_vert_f_code = motion_data[n].forw_vert_f_code;
-			cur_picture.back_hor_f_code = motion_data[n].back_hor_f_code;
-			cur_picture.back_vert_f_code = motion_data[n].back_vert_f_code;
-			sxf = motion_data[n].sxf;
-			syf = motion_data[n].syf;
-			sxb = motion_data[n].sxb;
-			syb = motion_data[n].syb;
-		}
+/* The picture may have been started during the previous picture */
+		if(!started && !start_picture(i, current)) break;
+		started = 0;
 
-		cur_picture.temp_ref = f - f0;
-		cur_picture.frame_pred_dct = frame_pred_dct_tab[cur_picture.pict_type - 1];
-		cur_picture.q_scale_type = qscale_tab[cur_picture.pict_type - 1];
-		cur_picture.intravlc = intravlc_tab[cur_picture.pict_type - 1];
-		cur_picture.altscan = altscan_tab[cur_picture.pict_type - 1];
-
-//printf("putseq 2 %d\n", cur_picture.frame_pred_dct);
-		readframe(f + frame0, cur_picture.curorg);
-		if(!frames_scaled) break;
-//printf("putseq 3 %p %p %p\n", curorg[0], curorg[1], curorg[2]);
-
-		mc_data.oldorg = oldorgframe;
-		mc_data.neworg = neworgframe;
-		mc_data.oldref = oldrefframe;
-		mc_data.newref = newrefframe;
-		mc_data.cur    = cur_picture.curorg;
-		mc_data.curref = cur_picture.curref;
-		mc_data.sxf = sxf;
-		mc_data.syf = syf;
-		mc_data.sxb = sxb;
-		mc_data.syb = syb;
+		put_gop(current);
+		picture = current->picture;
 
         if (fieldpic)
 		{
 //printf("putseq 4\n");
-			cur_picture.topfirst = opt_topfirst;
+			picture->topfirst = opt_topfirst;
 			if (!quiet)
 			{
 				fprintf(stderr,"\nfirst field  (%s) ",
-						cur_picture.topfirst ? "top" : "bot");
+						picture->topfirst ? "top" : "bot");
 				fflush(stderr);
 			}
 
-			cur_picture.pict_struct = cur_picture.topfirst ? TOP_FIELD : BOTTOM_FIELD;
+			picture->pict_struct = picture->topfirst ? TOP_FIELD : BOTTOM_FIELD;
 /* A.Stevens 2000: Append fast motion compensation data for new frame */
-			fast_motion_data(cur_picture.curorg[0], cur_picture.pict_struct);
-			motion_estimation(&cur_picture, &mc_data,0,0);
+			fast_motion_data(picture->curorg[0], picture->pict_struct);
+			motion_estimation(picture, &current->mc_data,0,0);
 
-			predict(&cur_picture,oldrefframe,newrefframe,predframe,0);
-			dct_type_estimation(&cur_picture,predframe[0],cur_picture.curorg[0]);
-			transform(&cur_picture,predframe,cur_picture.curorg);
+			predict(picture,oldrefframe,newrefframe,predframe,0);
+			dct_type_estimation(picture,predframe[0],picture->curorg[0]);
+			transform(picture,predframe,picture->curorg);
 
-			putpict(&cur_picture);		/* Quantisation: blocks -> qblocks */
+			putpict(picture);		/* Quantisation: blocks -> qblocks */
 #ifndef OUTPUT_STAT
-			if( cur_picture.pict_type!=B_TYPE)
+			if( picture->pict_type!=B_TYPE)
 			{
 #endif
-				iquantize( &cur_picture );
-				itransform(&cur_picture,predframe,cur_picture.curref);
+				iquantize( picture );
+				itransform(picture,predframe,picture->curref);
 /*
- * 				calcSNR(cur_picture.curorg,cur_picture.curref);
+ * 				calcSNR(picture->curorg,picture->curref);
  * 				stats();
  */
 #ifndef OUTPUT_STAT
@@ -269,41 +337,41 @@ void putseq()
 #endif
 			if (!quiet)
 			{
-				fprintf(stderr,"second field (%s) ",cur_picture.topfirst ? "bot" : "top");
+				fprintf(stderr,"second field (%s) ",picture->topfirst ? "bot" : "top");
 				fflush(stderr);
 			}
 
-			cur_picture.pict_struct = cur_picture.topfirst ? BOTTOM_FIELD : TOP_FIELD;
+			picture->pict_struct = picture->topfirst ? BOTTOM_FIELD : TOP_FIELD;
 
-			ipflag = (cur_picture.pict_type==I_TYPE);
+			ipflag = (picture->pict_type==I_TYPE);
 			if (ipflag)
 			{
 				/* first field = I, second field = P */
-				cur_picture.pict_type = P_TYPE;
-				cur_picture.forw_hor_f_code = motion_data[0].forw_hor_f_code;
-				cur_picture.forw_vert_f_code = motion_data[0].forw_vert_f_code;
-				cur_picture.back_hor_f_code = 
-					cur_picture.back_vert_f_code = 15;
+				picture->pict_type = P_TYPE;
+				picture->forw_hor_f_code = motion_data[0].forw_hor_f_code;
+				picture->forw_vert_f_code = motion_data[0].forw_vert_f_code;
+				picture->back_hor_f_code = 
+					picture->back_vert_f_code = 15;
 				sxf = motion_data[0].sxf;
 				syf = motion_data[0].syf;
 			}
 
-			motion_estimation(&cur_picture, &mc_data ,1,ipflag);
+			motion_estimation(picture, &current->mc_data ,1,ipflag);
 
-			predict(&cur_picture,oldrefframe,newrefframe,predframe,1);
-			dct_type_estimation(&cur_picture,predframe[0],cur_picture.curorg[0]);
-			transform(&cur_picture,predframe,cur_picture.curorg);
+			predict(picture,oldrefframe,newrefframe,predframe,1);
+			dct_type_estimation(picture,predframe[0],picture->curorg[0]);
+			transform(picture,predframe,picture->curorg);
 
-			putpict(&cur_picture);	/* Quantisation: blocks -> qblocks */
+			putpict(picture);	/* Quantisation: blocks -> qblocks */
 
 #ifndef OUTPUT_STAT
-			if( cur_picture.pict_type!=B_TYPE)
+			if( picture->pict_type!=B_TYPE)
 			{
 #endif
-				iquantize( &cur_picture );
-				itransform(&cur_picture,predframe,cur_picture.curref);
+				iquantize( picture );
+				itransform(picture,predframe,picture->curref);
 /*
- * 				calcSNR(cur_picture.curorg,cur_picture.curref);
+ * 				calcSNR(picture->curorg,picture->curref);
  * 				stats();
  */
 #ifndef OUTPUT_STAT
@@ -314,49 +382,52 @@ void putseq()
 		else
 		{
 //printf("putseq 5\n");
-			cur_picture.pict_struct = FRAME_PICTURE;
-			fast_motion_data(cur_picture.curorg[0], cur_picture.pict_struct);
-//printf("putseq 5\n");
-
-/* do motion_estimation
- *
- * uses source frames (...orgframe) for full pel search
- * and reconstructed frames (...refframe) for half pel search
- */
-
-			motion_estimation(&cur_picture,&mc_data,0,0);
+			motion_estimation_wait();
 
 //printf("putseq 5\n");
-			predict(&cur_picture, oldrefframe,newrefframe,predframe,0);
+			predict(picture, oldrefframe,newrefframe,predframe,0);
 //printf("putseq 5\n");
-			dct_type_estimation(&cur_picture,predframe[0],cur_picture.curorg[0]);
+			dct_type_estimation(picture,predframe[0],picture->curorg[0]);
 //printf("putseq 5\n");
 
-			transform(&cur_picture,predframe,cur_picture.curorg);
+			transform(picture,predframe,picture->curorg);
 //printf("putseq 5\n");
 
 /* Side-effect: quantisation blocks -> qblocks */
-			putpict(&cur_picture);	
+			putpict_start(picture);
+
+/* A B picture isn't a reference so the next picture's motion search */
+/* doesn't depend on it.  Search the next picture while the slices code. */
+			if(picture->pict_type == B_TYPE && i + 1 < frames_scaled)
+				started = start_picture(i + 1, ahead);
+
+			putpict_finish(picture);
 //printf("putseq 6\n");
 
 #ifndef OUTPUT_STAT
-			if( cur_picture.pict_type!=B_TYPE)
+			if( picture->pict_type!=B_TYPE)
 			{
 #endif
-				iquantize( &cur_picture );
+				iquantize( picture );
 //printf("putseq 5\n");
-				itransform(&cur_picture,predframe,cur_picture.curref);
+				itransform(picture,predframe,picture->curref);
 //printf("putseq 6\n");
 /*
- * 				calcSNR(cur_picture.curorg,cur_picture.curref);
+ * 				calcSNR(picture->curorg,picture->curref);
  * 				stats();
  */
 #ifndef OUTPUT_STAT
 			}
 #endif
 		}
-		writeframe(f + frame0, cur_picture.curref);
-			
+		writeframe(current->f + frame0, picture->curref);
+
+		if(started)
+		{
+			tmp = current;
+			current = ahead;
+			ahead = tmp;
+		}
 //printf("putseq 7\n");
 	}
 	putseqend();
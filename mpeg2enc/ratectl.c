@@ -256,7 +256,7 @@ static double calc_actj(pict_data_s *picture)
 			for( l = 0; l < 6; ++l )
 				actsum += 
 					(*pquant_weight_coeff_sum)
-					    ( cur_picture.mbinfo[k].dctblocks[l], i_q_mat ) ;
+					    ( picture->mbinfo[k].dctblocks[l], i_q_mat ) ;
 			actj = (double)actsum / (double)COEFFSUM_SCALE;
 			if( actj < 12.0 )
 				actj = 12.0;
@@ -111,3 +111,43 @@ void predcomp_11_mmx(char *src,char *dst,int lx, int w, int h, int addflag);
 void predcomp_01_mmx(char *src,char *dst,int lx, int w, int h, int addflag);
 
 #endif
+
+
+#ifdef X86_64_CPU
+
+int dist1_00_sse2(uint8_t *blk1, uint8_t *blk2, int lx, int h, int distlim);
+int dist1_01_sse2(uint8_t *blk1, uint8_t *blk2, int lx, int h);
+int dist1_10_sse2(uint8_t *blk1, uint8_t *blk2, int lx, int h);
+int dist1_11_sse2(uint8_t *blk1, uint8_t *blk2, int lx, int h);
+int dist22_sse2(uint8_t *blk1, uint8_t *blk2, int flx, int fh);
+int dist2_sse2(uint8_t *blk1, uint8_t *blk2,
+			   int lx, int hx, int hy, int h);
+int dist2_22_sse2(uint8_t *blk1, uint8_t *blk2,
+				  int lx, int h);
+int bdist2_22_sse2(uint8_t *blk1f, uint8_t *blk1b, 
+				   uint8_t *blk2,
+				   int lx, int h);
+int bdist1_sse2(uint8_t *pf, uint8_t *pb,
+				uint8_t *p2, int lx,
+				int hxf, int hyf, int hxb, int hyb, int h);
+int bdist2_sse2(uint8_t *pf, uint8_t *pb,
+				uint8_t *p2, int lx,
+				int hxf, int hyf, int hxb, int hyb, int h);
+int variance_sse2(uint8_t *p, int size, int lx);
+
+int dist1_11_avx2(uint8_t *blk1, uint8_t *blk2, int lx, int h);
+int bdist1_avx2(uint8_t *pf, uint8_t *pb,
+				uint8_t *p2, int lx,
+				int hxf, int hyf, int hxb, int hyb, int h);
+int bdist2_avx2(uint8_t *pf, uint8_t *pb,
+				uint8_t *p2, int lx,
+				int hxf, int hyf, int hxb, int hyb, int h);
+
+void predcomp_00_sse2(uint8_t *src, uint8_t *dst, int lx, int w, int h, int addflag);
+void predcomp_10_sse2(uint8_t *src, uint8_t *dst, int lx, int w, int h, int addflag);
+void predcomp_01_sse2(uint8_t *src, uint8_t *dst, int lx, int w, int h, int addflag);
+void predcomp_11_sse2(uint8_t *src, uint8_t *dst, int lx, int w, int h, int addflag);
+void add_pred_sse2(uint8_t *pred, uint8_t *cur, int lx, int16_t *blk);
+void sub_pred_sse2(uint8_t *pred, uint8_t *cur, int lx, int16_t *blk);
+
+#endif
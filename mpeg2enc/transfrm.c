@@ -32,6 +32,7 @@
 #include <stdio.h>
 #include <math.h>
 #include "cpu_accel.h"
+#include "simd.h"
 
 #ifdef X86_CPU
 extern void fdct_mmx( int16_t * blk );
@@ -43,6 +44,10 @@ void sub_pred_mmx (uint8_t *pred, uint8_t *cur,
 				   int lx, int16_t *blk);
 #endif
 
+#ifdef X86_64_CPU
+extern void fdct_sse2( int16_t * blk );
+#endif
+
 extern void fdct( int16_t *blk );
 extern void idct( int16_t *blk, unsigned char *temp );
 
@@ -87,6 +92,17 @@ void init_transform_hv()
 		psub_pred = sub_pred_mmx;
 	}
 	else
+#endif
+#ifdef X86_64_CPU
+	if( (flags & ACCEL_X86_SSE2) )
+	{
+		if(verbose) fprintf( stderr, "SETTING SSE2 for TRANSFORM!\n");
+		pfdct = fdct_sse2;
+		pidct = idct;
+		padd_pred = add_pred_sse2;
+		psub_pred = sub_pred_sse2;
+	}
+	else
 #endif
 	{
 		pfdct = fdct;
@@ -265,8 +281,6 @@ void transform(pict_data_s *picture,
 void start_transform_engines()
 {
 	int i;
-	int rows_per_processor = (int)((float)height2 / 16 / processors + 0.5);
-	int current_row = 0;
 	pthread_attr_t  attr;
 	pthread_mutexattr_t mutex_attr;
 
@@ -275,10 +289,8 @@ void start_transform_engines()
 	transform_engines = calloc(1, sizeof(transform_engine_t) * processors);
 	for(i = 0; i < processors; i++)
 	{
-		transform_engines[i].start_row = current_row * 16;
-		current_row += rows_per_processor;
-		if(current_row > height2 / 16) current_row = height2 / 16;
-		transform_engines[i].end_row = current_row * 16;
+		transform_engines[i].start_row = height2 / 16 * i / processors * 16;
+		transform_engines[i].end_row = height2 / 16 * (i + 1) / processors * 16;
 		pthread_mutex_init(&(transform_engines[i].input_lock), &mutex_attr);
 		pthread_mutex_lock(&(transform_engines[i].input_lock));
 		pthread_mutex_init(&(transform_engines[i].output_lock), &mutex_attr);
@@ -421,8 +433,6 @@ void itransform(pict_data_s *picture,
 void start_itransform_engines()
 {
 	int i;
-	int rows_per_processor = (int)((float)height2 / 16 / processors + 0.5);
-	int current_row = 0;
 	pthread_attr_t  attr;
 	pthread_mutexattr_t mutex_attr;
 
@@ -431,10 +441,8 @@ void start_itransform_engines()
 	itransform_engines = calloc(1, sizeof(transform_engine_t) * processors);
 	for(i = 0; i < processors; i++)
 	{
-		itransform_engines[i].start_row = current_row * 16;
-		current_row += rows_per_processor;
-		if(current_row > height2 / 16) current_row = height2 / 16;
-		itransform_engines[i].end_row = current_row * 16;
+		itransform_engines[i].start_row = height2 / 16 * i / processors * 16;
+		itransform_engines[i].end_row = height2 / 16 * (i + 1) / processors * 16;
 		pthread_mutex_init(&(itransform_engines[i].input_lock), &mutex_attr);
 		pthread_mutex_lock(&(itransform_engines[i].input_lock));
 		pthread_mutex_init(&(itransform_engines[i].output_lock), &mutex_attr);
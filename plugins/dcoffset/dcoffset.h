@@ -55,6 +55,7 @@ public:
 	VFrame* new_picon();
 	const char* plugin_title();
 	int is_realtime();
+	int get_sample_formats();
 
 	int need_collection;
 	Samples *reference;
@@ -89,6 +89,7 @@ public:
 	~DelayAudio();
 
 	int is_realtime();
+	int get_sample_formats();
 	void read_data(KeyFrame *keyframe);
 	void save_data(KeyFrame *keyframe);
 	int process_realtime(int64_t size, Samples *input_ptr, Samples *output_ptr);
@@ -98,7 +99,7 @@ public:
 
 	PLUGIN_CLASS_MEMBERS(DelayAudioConfig);
 	void reset();
-	void reconfigure();
+	void reconfigure(int format);
 	void update_gui();
 
 
@@ -50,6 +50,7 @@ public:
 	~Gain();
 
 	int process_realtime(int64_t size, Samples *input_ptr, Samples *output_ptr);
+	int get_sample_formats();
 
 	PLUGIN_CLASS_MEMBERS(GainConfig)
 	void save_data(KeyFrame *keyframe);
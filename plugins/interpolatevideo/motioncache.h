@@ -1 +0,0 @@
-../motion/motioncache.h
\ No newline at end of file
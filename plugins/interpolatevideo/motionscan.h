@@ -1 +0,0 @@
-../motion/motionscan.h
\ No newline at end of file
@@ -82,6 +82,7 @@ public:
     void reallocate_history(int new_allocation);
 
 	int is_realtime();
+	int get_sample_formats();
 	int is_synthesis();
 	int is_multichannel();
 	void save_data(KeyFrame *keyframe);
@@ -334,6 +334,28 @@ int quicktime_moov_delete(quicktime_moov_t *moov);
 int quicktime_moov_init(quicktime_moov_t *moov);
 int quicktime_shift_offsets(quicktime_moov_t *moov, int64_t offset);
 
+/* Fragmented MP4 */
+void quicktime_traf_init(quicktime_traf_t *traf);
+void quicktime_traf_delete(quicktime_traf_t *traf);
+int quicktime_write_fragment_data(quicktime_t *file, char *data, int size);
+void quicktime_update_traf(quicktime_t *file,
+	quicktime_trak_t *trak,
+	int64_t offset,
+	long size,
+	long duration);
+void quicktime_traf_keyframe(quicktime_trak_t *trak, int64_t frame);
+void quicktime_write_mvex(quicktime_t *file, quicktime_moov_t *moov);
+void quicktime_read_mvex(quicktime_t *file,
+	quicktime_moov_t *moov,
+	quicktime_atom_t *parent_atom);
+/* Write the buffered samples in a moof & mdat */
+void quicktime_flush_fragment(quicktime_t *file);
+/* Flush if the fragment has reached its duration or size */
+void quicktime_check_fragment(quicktime_t *file);
+/* The moof is followed by a complete mdat */
+int quicktime_fragment_complete(quicktime_t *file, quicktime_atom_t *moof_atom);
+void quicktime_read_moof(quicktime_t *file, quicktime_atom_t *moof_atom);
+
 
 void quicktime_mdat_delete(quicktime_mdat_t *mdat);
 void quicktime_read_mdat(quicktime_t *file, quicktime_mdat_t *mdat, quicktime_atom_t *parent_atom);
@@ -23,6 +23,14 @@ typedef struct
 	int initialized;
 	int quality;
 	int use_float;
+// Frames compressed or decompressed concurrently when there are several CPUs
+	mjpeg_pool_t *pool;
+// Frame after the last one decoded, for detecting sequential reading
+	int64_t next_frame;
+// Next frame to read ahead
+	int64_t read_frame;
+// Job last retrieved from the pool.  Valid until the next job is submitted.
+	mjpeg_job_t *last_job;
 } quicktime_jpeg_codec_t;
 
 static int delete_codec(quicktime_video_map_t *vtrack)
@@ -30,6 +38,7 @@ static int delete_codec(quicktime_video_map_t *vtrack)
 	quicktime_jpeg_codec_t *codec = ((quicktime_codec_t*)vtrack->codec)->priv;
 	int i;
 
+	if(codec->pool) mjpeg_pool_delete(codec->pool);
 	if(codec->mjpeg) mjpeg_delete(codec->mjpeg);
 	if(codec->buffer)
 		free(codec->buffer);
@@ -82,89 +91,219 @@ static void initialize(quicktime_video_map_t *vtrack)
 	}
 }
 
-static int decode(quicktime_t *file, 
-	unsigned char **row_pointers, 
-	int track)
+// Read the compressed frame into codec->buffer
+static int read_frame(quicktime_t *file, 
+	int track, 
+	int64_t frame, 
+	long *size, 
+	long *field2_offset)
 {
 	quicktime_video_map_t *vtrack = &(file->vtracks[track]);
-	initialize(vtrack);
 	quicktime_jpeg_codec_t *codec = ((quicktime_codec_t*)vtrack->codec)->priv;
 	quicktime_trak_t *trak = vtrack->track;
-	mjpeg_t *mjpeg = codec->mjpeg;
-	long size, field2_offset = 0;
-	int track_height = trak->tkhd.track_height;
-	int track_width = trak->tkhd.track_width;
-	int result = 0;
 	int field_dominance = trak->mdia.minf.stbl.stsd.table[0].field_dominance;
+	int result = 0;
 
-	mjpeg_set_cpus(codec->mjpeg, file->cpus);
-	if(file->row_span) 
-		mjpeg_set_rowspan(codec->mjpeg, file->row_span);
-	else
-		mjpeg_set_rowspan(codec->mjpeg, 0);
-
-	quicktime_set_video_position(file, vtrack->current_position, track);
-	size = quicktime_frame_size(file, vtrack->current_position, track);
-	codec->buffer_size = size;
+	quicktime_set_video_position(file, frame, track);
+	*size = quicktime_frame_size(file, frame, track);
+	*field2_offset = 0;
+	codec->buffer_size = *size;
 
 /*
- * printf("decode %d current_position=%ld offset=%lx size=%ld\n", 
+ * printf("read_frame %d current_position=%ld offset=%lx size=%ld\n", 
  * __LINE__, 
  * vtrack->current_position,
  * quicktime_ftell(file),
- * size);
+ * *size);
  */
 
-	if(size > codec->buffer_allocated)
+	if(*size > codec->buffer_allocated)
 	{
-		codec->buffer_allocated = size;
+		codec->buffer_allocated = *size;
 		codec->buffer = realloc(codec->buffer, codec->buffer_allocated);
 	}
 
-	result = !quicktime_read_data(file, codec->buffer, size);
-
-
-/*
- * printf("decode %d %02x %02x %02x %02x %02x %02x %02x %02x\n", 
- * __LINE__,
- * codec->buffer[0],
- * codec->buffer[1],
- * codec->buffer[2],
- * codec->buffer[3],
- * codec->buffer[4],
- * codec->buffer[5],
- * codec->buffer[6],
- * codec->buffer[7]);
- */
+	result = !quicktime_read_data(file, codec->buffer, *size);
 
-	if(!result)
+	if(!result && mjpeg_get_fields(codec->mjpeg) == 2)
 	{
-		if(mjpeg_get_fields(mjpeg) == 2)
+		if(file->use_avi)
 		{
-			if(file->use_avi)
-			{
-				field2_offset = mjpeg_get_avi_field2(codec->buffer, 
-					size, 
-					&field_dominance);
-			}
-			else
-			{
-				field2_offset = mjpeg_get_quicktime_field2(codec->buffer, 
-					size);
-// Sanity check
-				if(!field2_offset)
-				{
-					printf("decode: FYI field2_offset=0\n");
-					field2_offset = mjpeg_get_field2(codec->buffer, size);
-				}
-			}
+			*field2_offset = mjpeg_get_avi_field2(codec->buffer, 
+				*size, 
+				&field_dominance);
 		}
 		else
 		{
-			field2_offset = 0;
+			*field2_offset = mjpeg_get_quicktime_field2(codec->buffer, 
+				*size);
+// Sanity check
+			if(!*field2_offset)
+			{
+				printf("decode: FYI field2_offset=0\n");
+				*field2_offset = mjpeg_get_field2(codec->buffer, *size);
+			}
 		}
+	}
+
+	return result;
+}
+
+static void transfer_job(quicktime_t *file, 
+	unsigned char **row_pointers, 
+	mjpeg_job_t *job,
+	int direct,
+	int track_width)
+{
+	int out_rowspan = file->out_w;
 
+	if(direct && file->row_span) out_rowspan = file->row_span;
+	cmodel_transfer(row_pointers, 
+		job->rows,
+		row_pointers[0],
+		row_pointers[1],
+		row_pointers[2],
+		0, // out_a_plane
+		job->y,
+		job->u,
+		job->v,
+		0, // in_a_plane
+		file->in_x, 
+		file->in_y, 
+		file->in_w, 
+		file->in_h,
+		0, 
+		0, 
+		file->out_w, 
+		file->out_h,
+		job->color_model, 
+		file->color_model,
+		0,
+		track_width,
+		out_rowspan);
+}
+
+// Decompress several frames concurrently, reading ahead of the current 
+// frame when the frames are read in sequence.
+static int decode_pool(quicktime_t *file, 
+	unsigned char **row_pointers, 
+	int track)
+{
+	quicktime_video_map_t *vtrack = &(file->vtracks[track]);
+	quicktime_jpeg_codec_t *codec = ((quicktime_codec_t*)vtrack->codec)->priv;
+	quicktime_trak_t *trak = vtrack->track;
+	int track_height = trak->tkhd.track_height;
+	int track_width = trak->tkhd.track_width;
+	int64_t frame = vtrack->current_position;
+	int64_t length = quicktime_video_length(file, track);
+	int64_t read_end;
+	mjpeg_pool_t *pool;
+	mjpeg_job_t *job;
+	int direct = (file->in_x == 0 && 
+		file->in_y == 0 && 
+		file->in_w == track_width &&
+		file->in_h == track_height &&
+		file->out_w == track_width &&
+		file->out_h == track_height);
+// Decompress to the user colormodel if no scaling
+	int color_model = direct ? file->color_model : BC_YUV888;
+
+	if(!codec->pool)
+		codec->pool = mjpeg_pool_new(track_width, 
+			track_height, 
+			mjpeg_get_fields(codec->mjpeg),
+			file->cpus);
+	pool = codec->pool;
+
+// Same frame again.  Leave the read ahead running.
+	job = codec->last_job;
+	if(job && job->number == frame && job->color_model == color_model)
+	{
+		transfer_job(file, row_pointers, job, direct, track_width);
+		return job->result;
+	}
+
+// Skip the frames read ahead before the one requested & discard all of
+// them if it isn't among them.
+	if(mjpeg_pool_pending(pool))
+	{
+		job = pool->jobs[pool->tail];
+		if(job->color_model != color_model ||
+			frame < job->number ||
+			frame >= job->number + mjpeg_pool_pending(pool))
+			mjpeg_pool_reset(pool);
+		else
+		while(pool->jobs[pool->tail]->number != frame)
+			mjpeg_pool_wait(pool);
+	}
 
+	if(!mjpeg_pool_pending(pool)) codec->read_frame = frame;
+
+// Only read ahead when the frames are read in sequence
+	if(frame == codec->next_frame)
+		read_end = frame + pool->total;
+	else
+		read_end = frame + 1;
+	if(read_end > length) read_end = length;
+
+	while(!mjpeg_pool_full(pool) && codec->read_frame < read_end)
+	{
+		long size, field2_offset;
+		if(read_frame(file, track, codec->read_frame, &size, &field2_offset))
+			break;
+		mjpeg_pool_decompress(pool, 
+			codec->buffer, 
+			size, 
+			field2_offset, 
+			color_model, 
+			codec->read_frame);
+		codec->read_frame++;
+	}
+
+// Restore the position changed by reading ahead
+	quicktime_set_video_position(file, frame, track);
+	codec->next_frame = frame + 1;
+
+	codec->last_job = job = mjpeg_pool_wait(pool);
+	if(!job) return 1;
+
+	transfer_job(file, row_pointers, job, direct, track_width);
+	return job->result;
+}
+
+static int decode(quicktime_t *file, 
+	unsigned char **row_pointers, 
+	int track)
+{
+	quicktime_video_map_t *vtrack = &(file->vtracks[track]);
+	initialize(vtrack);
+	quicktime_jpeg_codec_t *codec = ((quicktime_codec_t*)vtrack->codec)->priv;
+	quicktime_trak_t *trak = vtrack->track;
+	long size, field2_offset = 0;
+	int track_height = trak->tkhd.track_height;
+	int track_width = trak->tkhd.track_width;
+	int result = 0;
+
+// Use the pool once the frames are read in sequence
+	if(file->cpus > 1 && 
+		(codec->pool || vtrack->current_position == codec->next_frame))
+		return decode_pool(file, row_pointers, track);
+	codec->next_frame = vtrack->current_position + 1;
+
+	mjpeg_set_cpus(codec->mjpeg, file->cpus);
+	if(file->row_span) 
+		mjpeg_set_rowspan(codec->mjpeg, file->row_span);
+	else
+		mjpeg_set_rowspan(codec->mjpeg, 0);
+
+	result = read_frame(file, 
+		track, 
+		vtrack->current_position, 
+		&size, 
+		&field2_offset);
+
+	if(!result)
+	{
 //printf("decode 2 %d\n", field2_offset);
 /*
  * printf("decode result=%d field1=%llx field2=%llx size=%d %02x %02x %02x %02x\n", 
@@ -260,44 +399,31 @@ static int decode(quicktime_t *file,
 	return result;
 }
 
-static int encode(quicktime_t *file, unsigned char **row_pointers, int track)
+// Write a compressed frame to the file
+static int write_frame(quicktime_t *file, mjpeg_t *mjpeg, int track)
 {
 	quicktime_video_map_t *vtrack = &(file->vtracks[track]);
-	initialize(vtrack);
 	quicktime_jpeg_codec_t *codec = ((quicktime_codec_t*)vtrack->codec)->priv;
 	quicktime_trak_t *trak = vtrack->track;
-	mjpeg_set_quality(codec->mjpeg, codec->quality);
-	mjpeg_set_float(codec->mjpeg, codec->use_float);
-	int64_t offset = quicktime_position(file);
 	int result = 0;
 	long field2_offset;
 	quicktime_atom_t chunk_atom;
 
-//printf("encode 1\n");
-	mjpeg_set_cpus(codec->mjpeg, file->cpus);
-
-	mjpeg_compress(codec->mjpeg, 
-		row_pointers, 
-		row_pointers[0], 
-		row_pointers[1], 
-		row_pointers[2],
-		file->color_model,
-		file->cpus);
 	if(codec->jpeg_type == JPEG_MJPA)
 	{
 		if(file->use_avi)
 		{
-			mjpeg_insert_avi_markers(&codec->mjpeg->output_data,
-				&codec->mjpeg->output_size,
-				&codec->mjpeg->output_allocated,
+			mjpeg_insert_avi_markers(&mjpeg->output_data,
+				&mjpeg->output_size,
+				&mjpeg->output_allocated,
 				2,
 				&field2_offset);
 		}
 		else
 		{
-			mjpeg_insert_quicktime_markers(&codec->mjpeg->output_data,
-				&codec->mjpeg->output_size,
-				&codec->mjpeg->output_allocated,
+			mjpeg_insert_quicktime_markers(&mjpeg->output_data,
+				&mjpeg->output_size,
+				&mjpeg->output_allocated,
 				2,
 				&field2_offset);
 		}
@@ -305,8 +431,8 @@ static int encode(quicktime_t *file, unsigned char **row_pointers, int track)
 
 	quicktime_write_chunk_header(file, trak, &chunk_atom);
 	result = !quicktime_write_data(file, 
-				mjpeg_output_buffer(codec->mjpeg), 
-				mjpeg_output_size(codec->mjpeg));
+				mjpeg_output_buffer(mjpeg), 
+				mjpeg_output_size(mjpeg));
 	quicktime_write_chunk_footer(file, 
 					trak,
 					vtrack->current_chunk,
@@ -314,10 +440,82 @@ static int encode(quicktime_t *file, unsigned char **row_pointers, int track)
 					1);
 
 	vtrack->current_chunk++;
+	return result;
+}
+
+static int encode(quicktime_t *file, unsigned char **row_pointers, int track)
+{
+	quicktime_video_map_t *vtrack = &(file->vtracks[track]);
+	initialize(vtrack);
+	quicktime_jpeg_codec_t *codec = ((quicktime_codec_t*)vtrack->codec)->priv;
+	quicktime_trak_t *trak = vtrack->track;
+	int result = 0;
+
+// Compress several frames concurrently & write them in order as they finish.
+// The last frames are written by flush.
+	if(file->cpus > 1)
+	{
+		if(!codec->pool)
+			codec->pool = mjpeg_pool_new(trak->tkhd.track_width, 
+				trak->tkhd.track_height, 
+				mjpeg_get_fields(codec->mjpeg),
+				file->cpus);
+
+		if(mjpeg_pool_full(codec->pool))
+		{
+			mjpeg_job_t *job = mjpeg_pool_wait(codec->pool);
+			result = write_frame(file, job->mjpeg, track);
+			if(job->result) result = 1;
+		}
+
+		mjpeg_pool_compress(codec->pool, 
+			row_pointers, 
+			row_pointers[0], 
+			row_pointers[1], 
+			row_pointers[2],
+			file->color_model,
+			codec->quality,
+			codec->use_float,
+			vtrack->current_position);
+		return result;
+	}
+
+	mjpeg_set_quality(codec->mjpeg, codec->quality);
+	mjpeg_set_float(codec->mjpeg, codec->use_float);
+
+//printf("encode 1\n");
+	mjpeg_set_cpus(codec->mjpeg, file->cpus);
+
+	mjpeg_compress(codec->mjpeg, 
+		row_pointers, 
+		row_pointers[0], 
+		row_pointers[1], 
+		row_pointers[2],
+		file->color_model,
+		file->cpus);
+	result = write_frame(file, codec->mjpeg, track);
 //printf("encode 100\n");
 	return result;
 }
 
+static void flush(quicktime_t *file, int track)
+{
+	quicktime_video_map_t *vtrack = &(file->vtracks[track]);
+	quicktime_jpeg_codec_t *codec = ((quicktime_codec_t*)vtrack->codec)->priv;
+	mjpeg_job_t *job;
+
+	if(!codec->pool) return;
+	while((job = mjpeg_pool_wait(codec->pool)))
+	{
+		if(job->compress)
+		{
+			if(job->result) 
+				printf("flush: frame %ld failed to compress\n", (long)job->number);
+			write_frame(file, job->mjpeg, track);
+		}
+	}
+}
+
 static int reads_colormodel(quicktime_t *file, 
 		int colormodel, 
 		int track)
@@ -399,6 +597,7 @@ static void init_codec_common(quicktime_video_map_t *vtrack, char *compressor)
 		codec->jpeg_type = JPEG_MJPA;
 	codec->quality = 80;
 	codec->use_float = 0;
+	codec->next_frame = -1;
 
 /* Init public items */
 	codec_base->delete_vcodec = delete_codec;
@@ -409,6 +608,7 @@ static void init_codec_common(quicktime_video_map_t *vtrack, char *compressor)
 	codec_base->reads_colormodel = reads_colormodel;
 	codec_base->writes_colormodel = writes_colormodel;
 	codec_base->set_parameter = set_parameter;
+	codec_base->flush = flush;
 	codec_base->fourcc = compressor;
 	codec_base->title = (codec->jpeg_type == JPEG_PROGRESSIVE ? "JPEG Photo" : "Motion JPEG A");
 	codec_base->desc = codec_base->title;
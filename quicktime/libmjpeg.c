@@ -1411,6 +1411,253 @@ void mjpeg_delete(mjpeg_t *mjpeg)
 }
 
 
+
+
+
+static void mjpeg_job_loop(mjpeg_job_t *job)
+{
+	pthread_mutex_lock(&job->lock);
+	while(1)
+	{
+		while(job->state != MJPEG_JOB_BUSY && !job->done)
+			pthread_cond_wait(&job->cond, &job->lock);
+		if(job->done) break;
+		pthread_mutex_unlock(&job->lock);
+
+		if(job->compress)
+			job->result = mjpeg_compress(job->mjpeg, 
+				job->rows, 
+				job->y, 
+				job->u, 
+				job->v,
+				job->color_model,
+				job->cpus);
+		else
+			job->result = mjpeg_decompress(job->mjpeg, 
+				job->input_data, 
+				job->input_size,
+				job->input_field2,  
+				job->rows, 
+				job->y, 
+				job->u, 
+				job->v,
+				job->color_model,
+				job->cpus);
+
+		pthread_mutex_lock(&job->lock);
+		job->state = MJPEG_JOB_DONE;
+		pthread_cond_broadcast(&job->cond);
+	}
+	pthread_mutex_unlock(&job->lock);
+}
+
+static mjpeg_job_t* mjpeg_new_job(mjpeg_pool_t *pool)
+{
+	pthread_attr_t attr;
+	mjpeg_job_t *result = calloc(1, sizeof(mjpeg_job_t));
+	result->pool = pool;
+	result->mjpeg = mjpeg_new(pool->w, pool->h, pool->fields);
+	result->color_model = -1;
+	result->rows = calloc(1, sizeof(unsigned char*) * pool->h);
+	pthread_mutex_init(&result->lock, 0);
+	pthread_cond_init(&result->cond, 0);
+	pthread_attr_init(&attr);
+	pthread_create(&result->tid, &attr, (void*)mjpeg_job_loop, result);
+	return result;
+}
+
+static void mjpeg_delete_job(mjpeg_job_t *job)
+{
+	pthread_mutex_lock(&job->lock);
+	job->done = 1;
+	pthread_cond_broadcast(&job->cond);
+	pthread_mutex_unlock(&job->lock);
+	pthread_join(job->tid, 0);
+	pthread_mutex_destroy(&job->lock);
+	pthread_cond_destroy(&job->cond);
+	mjpeg_delete(job->mjpeg);
+	if(job->frame_data) free(job->frame_data);
+	if(job->input_data) free(job->input_data);
+	free(job->rows);
+	free(job);
+}
+
+// Size of 1 chroma plane
+static int job_chroma_size(mjpeg_pool_t *pool, int color_model)
+{
+	switch(color_model)
+	{
+		case BC_YUV420P:
+			return (pool->w / 2) * (pool->h / 2);
+		case BC_YUV422P:
+			return (pool->w / 2) * pool->h;
+	}
+	return pool->w * pool->h;
+}
+
+static void allocate_job_frame(mjpeg_pool_t *pool, 
+	mjpeg_job_t *job, 
+	int color_model)
+{
+	int i;
+	if(job->frame_data && job->color_model == color_model) return;
+
+	if(job->frame_data) free(job->frame_data);
+	job->frame_data = malloc(cmodel_calculate_datasize(pool->w, 
+		pool->h, 
+		-1, 
+		color_model,
+		0));
+	job->color_model = color_model;
+
+	if(cmodel_is_planar(color_model))
+	{
+		job->y = job->frame_data;
+		job->u = job->y + pool->w * pool->h;
+		job->v = job->u + job_chroma_size(pool, color_model);
+		for(i = 0; i < pool->h; i++)
+			job->rows[i] = job->y + i * pool->w;
+	}
+	else
+	{
+		int bytes_per_line = cmodel_calculate_pixelsize(color_model) * pool->w;
+		job->y = job->u = job->v = 0;
+		for(i = 0; i < pool->h; i++)
+			job->rows[i] = job->frame_data + i * bytes_per_line;
+	}
+}
+
+static void start_job(mjpeg_pool_t *pool, mjpeg_job_t *job)
+{
+	job->cpus = pool->pending ? 1 : pool->total;
+	pthread_mutex_lock(&job->lock);
+	job->state = MJPEG_JOB_BUSY;
+	pthread_cond_broadcast(&job->cond);
+	pthread_mutex_unlock(&job->lock);
+	pool->head = (pool->head + 1) % pool->total;
+	pool->pending++;
+}
+
+mjpeg_pool_t* mjpeg_pool_new(int w, int h, int fields, int cpus)
+{
+	mjpeg_pool_t *result = calloc(1, sizeof(mjpeg_pool_t));
+	int i;
+	result->w = w;
+	result->h = h;
+	result->fields = fields;
+	result->total = cpus < 1 ? 1 : cpus;
+	result->jobs = calloc(1, sizeof(mjpeg_job_t*) * result->total);
+	for(i = 0; i < result->total; i++)
+		result->jobs[i] = mjpeg_new_job(result);
+	return result;
+}
+
+void mjpeg_pool_delete(mjpeg_pool_t *pool)
+{
+	int i;
+	mjpeg_pool_reset(pool);
+	for(i = 0; i < pool->total; i++)
+		mjpeg_delete_job(pool->jobs[i]);
+	free(pool->jobs);
+	free(pool);
+}
+
+int mjpeg_pool_pending(mjpeg_pool_t *pool)
+{
+	return pool->pending;
+}
+
+int mjpeg_pool_full(mjpeg_pool_t *pool)
+{
+	return pool->pending >= pool->total;
+}
+
+int mjpeg_pool_compress(mjpeg_pool_t *pool, 
+	unsigned char **row_pointers, 
+	unsigned char *y_plane, 
+	unsigned char *u_plane, 
+	unsigned char *v_plane,
+	int color_model,
+	int quality,
+	int use_float,
+	int64_t number)
+{
+	mjpeg_job_t *job;
+	int i;
+	if(mjpeg_pool_full(pool)) return 1;
+
+	job = pool->jobs[pool->head];
+	allocate_job_frame(pool, job, color_model);
+	if(cmodel_is_planar(color_model))
+	{
+		int chroma_size = job_chroma_size(pool, color_model);
+		memcpy(job->y, y_plane, pool->w * pool->h);
+		memcpy(job->u, u_plane, chroma_size);
+		memcpy(job->v, v_plane, chroma_size);
+	}
+	else
+	{
+		int bytes_per_line = cmodel_calculate_pixelsize(color_model) * pool->w;
+		for(i = 0; i < pool->h; i++)
+			memcpy(job->rows[i], row_pointers[i], bytes_per_line);
+	}
+
+	mjpeg_set_quality(job->mjpeg, quality);
+	mjpeg_set_float(job->mjpeg, use_float);
+	job->compress = 1;
+	job->number = number;
+	start_job(pool, job);
+	return 0;
+}
+
+int mjpeg_pool_decompress(mjpeg_pool_t *pool, 
+	unsigned char *buffer, 
+	long buffer_len,
+	long input_field2,  
+	int color_model,
+	int64_t number)
+{
+	mjpeg_job_t *job;
+	if(mjpeg_pool_full(pool)) return 1;
+
+	job = pool->jobs[pool->head];
+	allocate_job_frame(pool, job, color_model);
+	if(buffer_len > job->input_allocated)
+	{
+		job->input_allocated = buffer_len;
+		job->input_data = realloc(job->input_data, job->input_allocated);
+	}
+	memcpy(job->input_data, buffer, buffer_len);
+	job->input_size = buffer_len;
+	job->input_field2 = input_field2;
+	job->compress = 0;
+	job->number = number;
+	start_job(pool, job);
+	return 0;
+}
+
+mjpeg_job_t* mjpeg_pool_wait(mjpeg_pool_t *pool)
+{
+	mjpeg_job_t *job;
+	if(!pool->pending) return 0;
+
+	job = pool->jobs[pool->tail];
+	pthread_mutex_lock(&job->lock);
+	while(job->state != MJPEG_JOB_DONE)
+		pthread_cond_wait(&job->cond, &job->lock);
+	job->state = MJPEG_JOB_IDLE;
+	pthread_mutex_unlock(&job->lock);
+	pool->tail = (pool->tail + 1) % pool->total;
+	pool->pending--;
+	return job;
+}
+
+void mjpeg_pool_reset(mjpeg_pool_t *pool)
+{
+	while(mjpeg_pool_wait(pool))
+		;
+}
+
 /* Open up a space to insert a marker */
 static void insert_space(unsigned char **buffer, 
 	long *buffer_size, 
@@ -30,6 +30,7 @@ extern "C" {
 
 
 #include <stdio.h>
+#include <stdint.h>
 #include "jpeglib.h"
 #include <png.h>              /* Need setjmp.h as included by png.h */
 #include "pthread.h"
@@ -138,6 +139,52 @@ typedef struct
 
 
 
+// Frame level parallelism.  Whole frames are compressed or decompressed
+// concurrently by a pool of jobs, each with its own mjpeg_t, and retrieved
+// in the order they were submitted.
+#define MJPEG_JOB_IDLE 0
+#define MJPEG_JOB_BUSY 1
+#define MJPEG_JOB_DONE 2
+
+typedef struct
+{
+	void *pool;
+	mjpeg_t *mjpeg;
+	pthread_t tid;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	int state;
+	int done;
+	int compress;
+// Fields are split across CPUs only when the job is alone
+	int cpus;
+// Frame number or other identifier from the user
+	int64_t number;
+// Uncompressed frame owned by the job
+	int color_model;
+	unsigned char *frame_data;
+	unsigned char **rows;
+	unsigned char *y, *u, *v;
+// Compressed frame owned by the job
+	unsigned char *input_data;
+	long input_size;
+	long input_allocated;
+	long input_field2;
+	int result;
+} mjpeg_job_t;
+
+typedef struct
+{
+	int w, h, fields;
+	int total;
+	mjpeg_job_t **jobs;
+// Next job to submit
+	int head;
+// Oldest submitted job
+	int tail;
+	int pending;
+} mjpeg_pool_t;
+
 // Entry points
 mjpeg_t* mjpeg_new(int w, 
 	int h, 
@@ -216,6 +263,40 @@ long mjpeg_get_avi_field2(unsigned char *buffer,
 	int *field_dominance);
 long mjpeg_get_field2(unsigned char *buffer, long buffer_size);
 
+// Create a pool with 1 job per CPU
+mjpeg_pool_t* mjpeg_pool_new(int w, int h, int fields, int cpus);
+void mjpeg_pool_delete(mjpeg_pool_t *pool);
+// Number of jobs submitted but not retrieved
+int mjpeg_pool_pending(mjpeg_pool_t *pool);
+// No job can be submitted until the oldest is retrieved
+int mjpeg_pool_full(mjpeg_pool_t *pool);
+// Copy a frame into the next job & start compressing it.
+// The caller may reuse its frame when this returns.
+// Returns 1 if the pool is full.
+int mjpeg_pool_compress(mjpeg_pool_t *pool, 
+	unsigned char **row_pointers, 
+	unsigned char *y_plane, 
+	unsigned char *u_plane, 
+	unsigned char *v_plane,
+	int color_model,
+	int quality,
+	int use_float,
+	int64_t number);
+// Copy compressed data into the next job & start decompressing it into the
+// job's frame in the color model.
+// Returns 1 if the pool is full.
+int mjpeg_pool_decompress(mjpeg_pool_t *pool, 
+	unsigned char *buffer, 
+	long buffer_len,
+	long input_field2,  
+	int color_model,
+	int64_t number);
+// Wait for the oldest job.  Its output is valid until the next job is
+// submitted.  Returns 0 if no jobs are pending.
+mjpeg_job_t* mjpeg_pool_wait(mjpeg_pool_t *pool);
+// Wait for & discard all the pending jobs
+void mjpeg_pool_reset(mjpeg_pool_t *pool);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,513 @@
+#include "funcprotos.h"
+#include "quicktime.h"
+#include <string.h>
+
+
+/*
+ * Fragmented MP4 writing.
+ * The moov is written once at the first fragment with empty sample tables.
+ * After that, media data is buffered in memory & written in moof/mdat
+ * pairs every fragment_seconds or fragment_bytes, so the sample tables
+ * don't grow & the file is playable while it's being written.
+ */
+
+/* sample flags in the trun */
+#define SYNC_SAMPLE 0x02000000
+#define NON_SYNC_SAMPLE 0x01010000
+
+
+void quicktime_traf_init(quicktime_traf_t *traf)
+{
+	bzero(traf, sizeof(quicktime_traf_t));
+}
+
+void quicktime_traf_delete(quicktime_traf_t *traf)
+{
+	if(traf->table) free(traf->table);
+	traf->table = 0;
+	traf->total_entries = 0;
+	traf->entries_allocated = 0;
+	traf->base_time = 0;
+	traf->first_sample = 0;
+	traf->duration = 0;
+	traf->has_keyframes = 0;
+}
+
+int quicktime_write_fragment_data(quicktime_t *file, char *data, int size)
+{
+	int64_t offset = file->file_position - file->fragment_start;
+
+	if(offset + size > file->fragment_allocated)
+	{
+		int64_t new_allocation = file->fragment_allocated * 2;
+		if(new_allocation < offset + size) new_allocation = offset + size;
+		file->fragment_buffer = realloc(file->fragment_buffer, new_allocation);
+		if(!file->fragment_buffer) return 0;
+		file->fragment_allocated = new_allocation;
+	}
+
+	memcpy(file->fragment_buffer + offset, data, size);
+	file->file_position += size;
+	if(file->fragment_size < offset + size) file->fragment_size = offset + size;
+	return 1;
+}
+
+void quicktime_update_traf(quicktime_t *file,
+	quicktime_trak_t *trak,
+	int64_t offset,
+	long size,
+	long duration)
+{
+	quicktime_traf_t *traf = &trak->traf;
+	quicktime_trun_table_t *table;
+
+	if(traf->total_entries >= traf->entries_allocated)
+	{
+		traf->entries_allocated = traf->entries_allocated ?
+			traf->entries_allocated * 2 :
+			256;
+		traf->table = realloc(traf->table,
+			sizeof(quicktime_trun_table_t) * traf->entries_allocated);
+	}
+
+	table = &traf->table[traf->total_entries++];
+	table->offset = offset - file->fragment_start;
+	table->size = size;
+	table->duration = duration;
+	table->is_keyframe = 0;
+	traf->duration += duration;
+}
+
+void quicktime_traf_keyframe(quicktime_trak_t *trak, int64_t frame)
+{
+	quicktime_traf_t *traf = &trak->traf;
+	int64_t sample = frame - traf->first_sample;
+
+	traf->has_keyframes = 1;
+	if(sample >= 0 && sample < traf->total_entries)
+		traf->table[sample].is_keyframe = 1;
+}
+
+void quicktime_write_trex(quicktime_t *file, quicktime_trak_t *trak)
+{
+	quicktime_atom_t atom;
+	quicktime_atom_write_header(file, &atom, "trex");
+	quicktime_write_char(file, 0);
+	quicktime_write_int24(file, 0);
+	quicktime_write_int32(file, trak->tkhd.track_id);
+	quicktime_write_int32(file, 1);
+	quicktime_write_int32(file, 0);
+	quicktime_write_int32(file, 0);
+	quicktime_write_int32(file, 0);
+	quicktime_atom_write_footer(file, &atom);
+}
+
+void quicktime_write_mvex(quicktime_t *file, quicktime_moov_t *moov)
+{
+	quicktime_atom_t atom;
+	int i;
+	quicktime_atom_write_header(file, &atom, "mvex");
+	for(i = 0; i < moov->total_tracks; i++)
+		quicktime_write_trex(file, moov->trak[i]);
+	quicktime_atom_write_footer(file, &atom);
+}
+
+/* Write the traf & return the position of the data offset in the trun */
+static int64_t write_traf(quicktime_t *file, quicktime_trak_t *trak)
+{
+	quicktime_traf_t *traf = &trak->traf;
+	quicktime_atom_t traf_atom, atom;
+	int64_t data_offset;
+	int all_sync = !trak->mdia.minf.is_video || !traf->has_keyframes;
+	int i;
+
+	quicktime_atom_write_header(file, &traf_atom, "traf");
+
+/* default-base-is-moof */
+	quicktime_atom_write_header(file, &atom, "tfhd");
+	quicktime_write_char(file, 0);
+	quicktime_write_int24(file, 0x020000);
+	quicktime_write_int32(file, trak->tkhd.track_id);
+	quicktime_atom_write_footer(file, &atom);
+
+	quicktime_atom_write_header(file, &atom, "tfdt");
+	quicktime_write_char(file, 1);
+	quicktime_write_int24(file, 0);
+	quicktime_write_int64(file, traf->base_time);
+	quicktime_atom_write_footer(file, &atom);
+
+/* data offset, sample duration, size, flags */
+	quicktime_atom_write_header(file, &atom, "trun");
+	quicktime_write_char(file, 0);
+	quicktime_write_int24(file, 0x000701);
+	quicktime_write_int32(file, traf->total_entries);
+	data_offset = quicktime_position(file);
+	quicktime_write_int32(file, 0);
+	for(i = 0; i < traf->total_entries; i++)
+	{
+		quicktime_trun_table_t *table = &traf->table[i];
+		quicktime_write_int32(file, table->duration);
+		quicktime_write_int32(file, table->size);
+		quicktime_write_int32(file,
+			(all_sync || table->is_keyframe) ? SYNC_SAMPLE : NON_SYNC_SAMPLE);
+	}
+	quicktime_atom_write_footer(file, &atom);
+
+	quicktime_atom_write_footer(file, &traf_atom);
+	return data_offset;
+}
+
+void quicktime_flush_fragment(quicktime_t *file)
+{
+	quicktime_moov_t *moov = &file->moov;
+	quicktime_atom_t moof_atom, atom;
+	int64_t data_offset[MAXTRACKS];
+	int64_t data_start[MAXTRACKS];
+	int64_t end;
+	int total_samples = 0;
+	int i, j;
+
+	file->buffer_fragment = 0;
+	quicktime_set_position(file, file->fragment_start);
+	quicktime_set_presave(file, 1);
+
+/* The codec headers are known after the first fragment is compressed */
+	if(!file->have_init)
+	{
+		quicktime_write_moov(file, moov, 0);
+		file->have_init = 1;
+	}
+
+	for(i = 0; i < moov->total_tracks; i++)
+		total_samples += moov->trak[i]->traf.total_entries;
+
+	if(total_samples)
+	{
+		int64_t moof_start = quicktime_position(file);
+		quicktime_atom_write_header(file, &moof_atom, "moof");
+
+		quicktime_atom_write_header(file, &atom, "mfhd");
+		quicktime_write_char(file, 0);
+		quicktime_write_int24(file, 0);
+		quicktime_write_int32(file, ++file->fragment_sequence);
+		quicktime_atom_write_footer(file, &atom);
+
+		for(i = 0; i < moov->total_tracks; i++)
+		{
+			if(moov->trak[i]->traf.total_entries)
+				data_offset[i] = write_traf(file, moov->trak[i]);
+		}
+		quicktime_atom_write_footer(file, &moof_atom);
+
+/* Samples of each track are contiguous in the mdat */
+		if(file->fragment_size + 8 > 0xffffffffLL)
+			quicktime_atom_write_header64(file, &atom, "mdat");
+		else
+			quicktime_atom_write_header(file, &atom, "mdat");
+		for(i = 0; i < moov->total_tracks; i++)
+		{
+			quicktime_traf_t *traf = &moov->trak[i]->traf;
+			data_start[i] = quicktime_position(file);
+			for(j = 0; j < traf->total_entries; j++)
+			{
+				quicktime_write_data(file,
+					file->fragment_buffer + traf->table[j].offset,
+					traf->table[j].size);
+			}
+		}
+		quicktime_atom_write_footer(file, &atom);
+		end = quicktime_position(file);
+
+		for(i = 0; i < moov->total_tracks; i++)
+		{
+			if(moov->trak[i]->traf.total_entries)
+			{
+				quicktime_set_position(file, data_offset[i]);
+				quicktime_write_int32(file, data_start[i] - moof_start);
+			}
+		}
+	}
+	else
+		end = quicktime_position(file);
+
+	quicktime_set_presave(file, 0);
+	quicktime_set_position(file, end);
+
+	for(i = 0; i < moov->total_tracks; i++)
+	{
+		quicktime_traf_t *traf = &moov->trak[i]->traf;
+		traf->first_sample += traf->total_entries;
+		traf->base_time += traf->duration;
+		traf->duration = 0;
+		traf->total_entries = 0;
+	}
+
+	file->fragment_start = end;
+	file->fragment_size = 0;
+	file->buffer_fragment = 1;
+}
+
+void quicktime_check_fragment(quicktime_t *file)
+{
+	quicktime_moov_t *moov = &file->moov;
+	int i;
+
+	if(!file->fragment_size) return;
+
+	if(file->fragment_size >= file->fragment_bytes)
+	{
+		quicktime_flush_fragment(file);
+		return;
+	}
+
+	for(i = 0; i < moov->total_tracks; i++)
+	{
+		quicktime_trak_t *trak = moov->trak[i];
+		if(trak->traf.duration >=
+			file->fragment_seconds * trak->mdia.mdhd.time_scale)
+		{
+			quicktime_flush_fragment(file);
+			return;
+		}
+	}
+}
+
+
+
+
+/* Reading fragments */
+
+static void append_stts(quicktime_stts_t *stts, long count, long duration)
+{
+	quicktime_stts_table_t *table = 0;
+
+	if(stts->total_entries)
+		table = &stts->table[stts->total_entries - 1];
+
+	if(table && table->sample_duration == duration)
+	{
+		table->sample_count += count;
+	}
+	else
+	if(table && !table->sample_count)
+	{
+		table->sample_duration = duration;
+		table->sample_count = count;
+	}
+	else
+	{
+		stts->total_entries++;
+		stts->table = realloc(stts->table,
+			sizeof(quicktime_stts_table_t) * stts->total_entries);
+		table = &stts->table[stts->total_entries - 1];
+		table->sample_duration = duration;
+		table->sample_count = count;
+	}
+}
+
+static void append_stsc(quicktime_stsc_t *stsc, long chunk, long samples)
+{
+	quicktime_stsc_table_t *table;
+
+	if(stsc->total_entries)
+	{
+		table = &stsc->table[stsc->total_entries - 1];
+		if(table->samples == samples) return;
+/* Replace the empty entry of the moov */
+		if(table->chunk == chunk)
+		{
+			table->samples = samples;
+			return;
+		}
+	}
+
+	if(stsc->total_entries >= stsc->entries_allocated)
+	{
+		stsc->entries_allocated = stsc->total_entries * 2 + 16;
+		stsc->table = realloc(stsc->table,
+			sizeof(quicktime_stsc_table_t) * stsc->entries_allocated);
+	}
+
+	table = &stsc->table[stsc->total_entries++];
+	table->chunk = chunk;
+	table->samples = samples;
+	table->id = 1;
+}
+
+static void append_sample(quicktime_trak_t *trak,
+	int64_t offset,
+	long size,
+	long duration,
+	int is_keyframe)
+{
+	quicktime_stbl_t *stbl = &trak->mdia.minf.stbl;
+	long chunk = stbl->stco.total_entries + 1;
+
+	quicktime_update_stco(&stbl->stco, chunk, offset);
+
+	if(trak->mdia.minf.is_audio && stbl->stsz.sample_size)
+	{
+/* PCM audio.  The sample is a chunk of frames */
+		append_stsc(&stbl->stsc, chunk, duration);
+		append_stts(&stbl->stts, duration, 1);
+	}
+	else
+	{
+		quicktime_stsz_t *stsz = &stbl->stsz;
+		quicktime_stss_t *stss = &stbl->stss;
+
+		append_stsc(&stbl->stsc, chunk, 1);
+		append_stts(&stbl->stts, 1, duration);
+
+		if(stsz->total_entries >= stsz->entries_allocated)
+		{
+			stsz->entries_allocated = stsz->total_entries * 2 + 1024;
+			stsz->table = realloc(stsz->table,
+				sizeof(quicktime_stsz_table_t) * stsz->entries_allocated);
+		}
+		quicktime_update_stsz(stsz, stsz->total_entries, size);
+
+		if(trak->mdia.minf.is_video && is_keyframe)
+		{
+			if(stss->total_entries >= stss->entries_allocated)
+			{
+				stss->entries_allocated = stss->total_entries * 2 + 16;
+				stss->table = realloc(stss->table,
+					sizeof(quicktime_stss_table_t) * stss->entries_allocated);
+			}
+			stss->table[stss->total_entries++].sample = stsz->total_entries;
+		}
+	}
+}
+
+static quicktime_trak_t* get_trak(quicktime_moov_t *moov, long track_id)
+{
+	int i;
+	for(i = 0; i < moov->total_tracks; i++)
+		if(moov->trak[i]->tkhd.track_id == track_id) return moov->trak[i];
+	return 0;
+}
+
+void quicktime_read_mvex(quicktime_t *file,
+	quicktime_moov_t *moov,
+	quicktime_atom_t *parent_atom)
+{
+	quicktime_atom_t leaf_atom;
+
+	do
+	{
+		quicktime_atom_read_header(file, &leaf_atom);
+		if(quicktime_atom_is(&leaf_atom, "trex"))
+		{
+			quicktime_trex_t trex;
+			quicktime_trak_t *trak;
+			quicktime_read_char(file);
+			quicktime_read_int24(file);
+			trex.track_id = quicktime_read_int32(file);
+			trex.default_sample_description_index = quicktime_read_int32(file);
+			trex.default_sample_duration = quicktime_read_int32(file);
+			trex.default_sample_size = quicktime_read_int32(file);
+			trex.default_sample_flags = quicktime_read_int32(file);
+			if((trak = get_trak(moov, trex.track_id))) trak->trex = trex;
+		}
+		quicktime_atom_skip(file, &leaf_atom);
+	}while(quicktime_position(file) < parent_atom->end);
+}
+
+static void read_traf(quicktime_t *file,
+	quicktime_atom_t *moof_atom,
+	quicktime_atom_t *parent_atom)
+{
+	quicktime_atom_t leaf_atom;
+	quicktime_trak_t *trak = 0;
+	int64_t base_offset = moof_atom->start;
+	int64_t offset = base_offset;
+	long default_duration = 0;
+	long default_size = 0;
+	long default_flags = 0;
+	long flags;
+	long i, total_entries;
+
+	do
+	{
+		quicktime_atom_read_header(file, &leaf_atom);
+		if(quicktime_atom_is(&leaf_atom, "tfhd"))
+		{
+			quicktime_read_char(file);
+			flags = quicktime_read_int24(file);
+			trak = get_trak(&file->moov, quicktime_read_int32(file));
+			if(!trak) return;
+
+			default_duration = trak->trex.default_sample_duration;
+			default_size = trak->trex.default_sample_size;
+			default_flags = trak->trex.default_sample_flags;
+			if(flags & 0x1) base_offset = quicktime_read_int64(file);
+			if(flags & 0x2) quicktime_read_int32(file);
+			if(flags & 0x8) default_duration = quicktime_read_int32(file);
+			if(flags & 0x10) default_size = quicktime_read_int32(file);
+			if(flags & 0x20) default_flags = quicktime_read_int32(file);
+			offset = base_offset;
+		}
+		else
+		if(quicktime_atom_is(&leaf_atom, "trun") && trak)
+		{
+			long first_flags = default_flags;
+			quicktime_read_char(file);
+			flags = quicktime_read_int24(file);
+			total_entries = quicktime_read_int32(file);
+			if(flags & 0x1) offset = base_offset + (int32_t)quicktime_read_int32(file);
+			if(flags & 0x4) first_flags = quicktime_read_int32(file);
+
+			for(i = 0; i < total_entries; i++)
+			{
+				long duration = default_duration;
+				long size = default_size;
+				long sample_flags = i ? default_flags : first_flags;
+				if(flags & 0x100) duration = quicktime_read_int32(file);
+				if(flags & 0x200) size = quicktime_read_int32(file);
+				if(flags & 0x400) sample_flags = quicktime_read_int32(file);
+				if(flags & 0x800) quicktime_read_int32(file);
+
+				append_sample(trak,
+					offset,
+					size,
+					duration,
+					!(sample_flags & 0x10000));
+				offset += size;
+			}
+		}
+		quicktime_atom_skip(file, &leaf_atom);
+	}while(quicktime_position(file) < parent_atom->end);
+}
+
+/* The moof is only usable if its mdat follows it & ends inside the file */
+int quicktime_fragment_complete(quicktime_t *file, quicktime_atom_t *moof_atom)
+{
+	quicktime_atom_t mdat_atom;
+	int64_t position = quicktime_position(file);
+	int result = 0;
+
+	if(moof_atom->end > file->total_length) return 0;
+
+	quicktime_set_position(file, moof_atom->end);
+	if(!quicktime_atom_read_header(file, &mdat_atom) &&
+		quicktime_atom_is(&mdat_atom, "mdat") &&
+		mdat_atom.end <= file->total_length)
+		result = 1;
+	quicktime_set_position(file, position);
+
+	return result;
+}
+
+void quicktime_read_moof(quicktime_t *file, quicktime_atom_t *moof_atom)
+{
+	quicktime_atom_t leaf_atom;
+
+	do
+	{
+		quicktime_atom_read_header(file, &leaf_atom);
+		if(quicktime_atom_is(&leaf_atom, "traf"))
+			read_traf(file, moof_atom, &leaf_atom);
+		quicktime_atom_skip(file, &leaf_atom);
+	}while(quicktime_position(file) < moof_atom->end);
+}
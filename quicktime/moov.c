@@ -215,6 +215,11 @@ int quicktime_read_moov(quicktime_t *file,
 		{
 			quicktime_read_ctab(file, &(moov->ctab));
 		}
+		else
+		if(quicktime_atom_is(&leaf_atom, "mvex"))
+		{
+			quicktime_read_mvex(file, moov, &leaf_atom);
+		}
 		else
 			quicktime_atom_skip(file, &leaf_atom);
 	}while(quicktime_position(file) < parent_atom->end);
@@ -270,6 +275,7 @@ void quicktime_write_moov(quicktime_t *file,
 	{
 		quicktime_write_trak(file, moov->trak[i], moov->mvhd.time_scale);
 	}
+	if(file->use_fragments) quicktime_write_mvex(file, moov);
 	/*quicktime_write_ctab(file, &(moov->ctab)); */
 
 	quicktime_atom_write_footer(file, &atom);
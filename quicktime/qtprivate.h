@@ -459,7 +459,40 @@ typedef struct
 	quicktime_elst_t elst;
 } quicktime_edts_t;
 
+/* track defaults for movie fragments */
+typedef struct
+{
+	long track_id;
+	long default_sample_description_index;
+	long default_sample_duration;
+	long default_sample_size;
+	long default_sample_flags;
+} quicktime_trex_t;
+
+/* samples of the fragment being written */
+typedef struct
+{
+/* Offset of the sample in the fragment buffer */
+	int64_t offset;
+	long size;
+	long duration;
+	int is_keyframe;
+} quicktime_trun_table_t;
 
+typedef struct
+{
+	long total_entries;
+	long entries_allocated;
+	quicktime_trun_table_t *table;
+/* Decode time of the first sample in the fragment */
+	int64_t base_time;
+/* Number of the first sample in the fragment */
+	int64_t first_sample;
+/* Total duration of the samples in the fragment */
+	int64_t duration;
+/* Keyframes are being inserted so the other samples aren't sync samples */
+	int has_keyframes;
+} quicktime_traf_t;
 
 
 typedef struct
@@ -467,6 +500,8 @@ typedef struct
 	quicktime_tkhd_t tkhd;
 	quicktime_mdia_t mdia;
 	quicktime_edts_t edts;
+	quicktime_trex_t trex;
+	quicktime_traf_t traf;
 } quicktime_trak_t;
 
 
@@ -751,6 +786,26 @@ typedef struct
 	int is_sphere;
 
 
+/* Fragmented MP4 section */
+	int use_fragments;
+/* Write a fragment after this much time or data */
+	double fragment_seconds;
+	int64_t fragment_bytes;
+/* Sequence number of the next moof */
+	long fragment_sequence;
+/* The moov has been written */
+	int have_init;
+/* Media data is stored in fragment_buffer until the moof is written */
+	int buffer_fragment;
+/* Position in the file of the next moof */
+	int64_t fragment_start;
+	char *fragment_buffer;
+	int64_t fragment_size;
+	int64_t fragment_allocated;
+/* Default limit of the fragment buffer */
+#define QUICKTIME_FRAGMENT_BYTES 0x4000000
+
+
 
 
 
@@ -203,6 +203,19 @@ void quicktime_set_sphere(quicktime_t *file, int value)
 	file->is_sphere = value;
 }
 
+void quicktime_set_fragments(quicktime_t *file, double seconds, int64_t bytes)
+{
+	if(!file->wr || file->use_avi || seconds <= 0 || file->use_fragments) return;
+
+	file->use_fragments = 1;
+	file->fragment_seconds = seconds;
+	file->fragment_bytes = bytes > 0 ? bytes : QUICKTIME_FRAGMENT_BYTES;
+/* The moov replaces the mdat header */
+	file->fragment_start = file->mdat.atom.start;
+	quicktime_set_position(file, file->fragment_start);
+	file->buffer_fragment = 1;
+}
+
 char* quicktime_get_copyright(quicktime_t *file)
 {
 	return file->moov.udta.copyright;
@@ -382,6 +395,9 @@ int quicktime_delete(quicktime_t *file)
 	if(file->moov_data)
 		free(file->moov_data);
 
+	if(file->fragment_buffer)
+		free(file->fragment_buffer);
+
 	if(file->preload_size)
 	{
 		free(file->preload_buffer);
@@ -982,6 +998,13 @@ void quicktime_insert_keyframe(quicktime_t *file, int64_t frame, int track)
 			trak,
 			frame);
 
+// Sync samples are flagged in the moof
+	if(file->use_fragments)
+	{
+		quicktime_traf_keyframe(trak, frame);
+		return;
+	}
+
 // Offset 1
 	frame++;
 
@@ -1317,6 +1340,15 @@ int quicktime_read_info(quicktime_t *file)
 					got_header = 1;
 				}
 				else
+/* Fragments after the moov.  The last one may be incomplete. */
+				if(quicktime_atom_is(&leaf_atom, "moof") && 
+					got_header)
+				{
+					if(!quicktime_fragment_complete(file, &leaf_atom)) break;
+					quicktime_read_moof(file, &leaf_atom);
+					quicktime_atom_skip(file, &leaf_atom);
+				}
+				else
 					quicktime_atom_skip(file, &leaf_atom);
 			}
 		}while(!result && quicktime_position(file) < file->total_length);
@@ -1561,6 +1593,12 @@ int quicktime_close(quicktime_t *file)
 			quicktime_atom_write_footer(file, &junk_atom);
 		}
 		else
+		if(file->use_fragments)
+		{
+			if(file->stream) quicktime_flush_fragment(file);
+			file->buffer_fragment = 0;
+		}
+		else
 		{
 // Atoms are only written here
 			if(file->stream)
@@ -196,6 +196,10 @@ void quicktime_set_name(quicktime_t *file, const char *string);
 void quicktime_set_info(quicktime_t *file, const char *string);
 /* tag the file for spherical playback */
 void quicktime_set_sphere(quicktime_t *file, int value);
+/* Write a fragmented MP4 with a moof & mdat every seconds or bytes. */
+/* Must be called after opening, before writing any data. */
+/* bytes = 0 uses the default limit. */
+void quicktime_set_fragments(quicktime_t *file, double seconds, int64_t bytes);
 char* quicktime_get_copyright(quicktime_t *file);
 char* quicktime_get_name(quicktime_t *file);
 char* quicktime_get_info(quicktime_t *file);
@@ -12,6 +12,7 @@ int quicktime_trak_init(quicktime_trak_t *trak)
 	quicktime_tkhd_init(&(trak->tkhd));
 	quicktime_edts_init(&(trak->edts));
 	quicktime_mdia_init(&(trak->mdia));
+	quicktime_traf_init(&(trak->traf));
 	return 0;
 }
 
@@ -58,6 +59,7 @@ int quicktime_trak_delete(quicktime_trak_t *trak)
 {
 	quicktime_mdia_delete(&(trak->mdia));
 	quicktime_edts_delete(&(trak->edts));
+	quicktime_traf_delete(&(trak->traf));
 	quicktime_tkhd_delete(&(trak->tkhd));
 	return 0;
 }
@@ -175,7 +177,9 @@ int quicktime_write_trak(quicktime_t *file,
 	trak->mdia.mdhd.time_scale = timescale;
 
 	quicktime_write_tkhd(file, &(trak->tkhd));
-	quicktime_write_edts(file, &(trak->edts), trak->tkhd.duration);
+// The edit list would be the duration of the empty sample tables
+	if(!file->use_fragments)
+		quicktime_write_edts(file, &(trak->edts), trak->tkhd.duration);
 	quicktime_write_mdia(file, &(trak->mdia));
 
 
@@ -551,6 +555,7 @@ void quicktime_write_chunk_header(quicktime_t *file,
 	}
 	else
 	{
+		if(file->use_fragments) quicktime_check_fragment(file);
 		chunk->start = quicktime_position(file);
 	}
 }
@@ -586,6 +591,17 @@ void quicktime_write_chunk_footer(quicktime_t *file,
 			sample_size);
 	}
 
+// Sample tables are written in the moof
+	if(file->use_fragments)
+	{
+		quicktime_update_traf(file, 
+			trak, 
+			offset, 
+			sample_size, 
+			samples * quicktime_sample_duration(trak));
+		return;
+	}
+
 	if(offset + sample_size > file->mdat.atom.size)
 		file->mdat.atom.size = offset + sample_size;
 
@@ -639,6 +655,14 @@ int quicktime_write_vbr_frame(quicktime_t *file,
 			data_size);
 	}
 
+// Sample tables are written in the moof
+	if(file->use_fragments)
+	{
+		trak->mdia.minf.stbl.stts.is_vbr = 1;
+		quicktime_update_traf(file, trak, offset, data_size, samples);
+		return result;
+	}
+
 // Update MDAT size
 	if(offset + data_size > file->mdat.atom.size)
 		file->mdat.atom.size = offset + data_size;
@@ -695,7 +719,9 @@ int quicktime_trak_fix_counts(quicktime_t *file, quicktime_trak_t *trak)
 	{
 		trak->mdia.minf.stbl.stts.table[0].sample_count = samples;
 
-		if(!trak->mdia.minf.stbl.stsz.total_entries)
+// Video in a fragmented file gets its sample sizes from the moofs
+		if(!trak->mdia.minf.stbl.stsz.total_entries &&
+			(!file->use_fragments || !trak->mdia.minf.is_video))
 		{
 			trak->mdia.minf.stbl.stsz.sample_size = 1;
 			trak->mdia.minf.stbl.stsz.total_entries = samples;
@@ -245,6 +245,10 @@ int quicktime_write_data(quicktime_t *file, char *data, int size)
 	int writes_succeeded = 0;
 	int iterations = 0;
 
+/* Store media data until the moof is written */
+	if(file->buffer_fragment)
+		return quicktime_write_fragment_data(file, data, size);
+
 	if(!file->use_presave)
 	{
 //printf("quicktime_write_data 1\n");
@@ -663,7 +667,7 @@ int64_t quicktime_position(quicktime_t *file)
 int quicktime_set_position(quicktime_t *file, int64_t position) 
 {
 	file->file_position = position;
-	if(!file->use_presave)
+	if(!file->use_presave && !file->buffer_fragment)
 	{
 		quicktime_fseek(file, position);
 		file->presave_position = position;